@@ -1,149 +0,0 @@
-<?xml version="1.0" encoding="utf-8"?>
-<!DOCTYPE TS>
-<TS version="2.1" language="ru_RU" sourcelanguage="en_US">
-<context>
-    <name>Form</name>
-    <message>
-        <location filename="form.cpp" line="114"/>
-        <source>Initial profile</source>
-        <translation>Начальный профиль импульса</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="135"/>
-        <source>Pulse form</source>
-        <translation>Форма импульса</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="137"/>
-        <source>Gauss</source>
-        <translation>Гаусс</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="138"/>
-        <source>SuperGauss</source>
-        <translation>Супергаусс</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="139"/>
-        <source>Rectangle</source>
-        <translation>Прямоугольник</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="140"/>
-        <source>Step</source>
-        <translation>Ступенька</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="142"/>
-        <source>Grid size</source>
-        <translation>Размер сетки</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="143"/>
-        <source> L = </source>
-        <translation> L = </translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="145"/>
-        <source>Integration time</source>
-        <translation>Время интегрирования</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="146"/>
-        <source> T = </source>
-        <translation> T = </translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="148"/>
-        <source>Number of spatial points</source>
-        <translation>Количество точек по пространству</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="149"/>
-        <source>NX = </source>
-        <translation>NX = </translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="151"/>
-        <source>Number of temporal points</source>
-        <translation>Количество точек по времени</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="152"/>
-        <source>NT = </source>
-        <translation>NT = </translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="183"/>
-        <source>Spatial step</source>
-        <translation>Шаг по пространству</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="184"/>
-        <source>dx = </source>
-        <translation>dx = </translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="188"/>
-        <source>Time step</source>
-        <translation>Шаг по времени</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="189"/>
-        <source>dt = </source>
-        <translation>dt = </translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="193"/>
-        <source>CFL number</source>
-        <translation>Число CFL</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="194"/>
-        <source>α = </source>
-        <oldsource>CFL = </oldsource>
-        <translation>α = </translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="199"/>
-        <source>Start</source>
-        <translation>Старт</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="206"/>
-        <location filename="form.cpp" line="290"/>
-        <location filename="form.cpp" line="374"/>
-        <source>Dispersion error</source>
-        <translation>Дисперсия</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="233"/>
-        <location filename="form.cpp" line="317"/>
-        <location filename="form.cpp" line="401"/>
-        <source>Dissipation error</source>
-        <translation>Диссипация</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="258"/>
-        <location filename="form.cpp" line="342"/>
-        <location filename="form.cpp" line="426"/>
-        <source>Solution</source>
-        <translation>Решение</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="454"/>
-        <source>Upwind</source>
-        <translation>Схема бегущего счета</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="455"/>
-        <source>Lax-Friedrichs</source>
-        <translation>Схема Лакса-Фридрихса</translation>
-    </message>
-    <message>
-        <location filename="form.cpp" line="456"/>
-        <source>Lax-Wendroff</source>
-        <translation>Схема Лакса-Вендроффа</translation>
-    </message>
-</context>
-</TS>
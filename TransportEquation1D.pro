@@ -4,35 +4,18 @@
 #
 #-------------------------------------------------
 
-QT       += core gui charts
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-TARGET = TransportEquation1D
-TEMPLATE = app
-
-# The following define makes your compiler emit warnings if you use
-# any feature of Qt which has been marked as deprecated (the exact warnings
-# depend on your compiler). Please consult the documentation of the
-# deprecated API in order to know how to port your code away from it.
-DEFINES += QT_DEPRECATED_WARNINGS
-
-# You can also make your code fail to compile if you use deprecated APIs.
-# In order to do so, uncomment the following line.
-# You can also select to disable deprecated APIs only up to a certain version of Qt.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-
-SOURCES += \
-        main.cpp \
-        form.cpp \
-    parameters.cpp
-
-HEADERS += \
-        form.h \
-    parameters.h
-
-TRANSLATIONS += TransferEquation1D_rus.ts
-
-LIBS += "$$PWD/libfftw3-3.dll"
-
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    solver \
+    gui \
+    cli \
+    sweep \
+    convergence \
+    bench
+
+gui.depends = solver
+cli.depends = solver
+sweep.depends = solver
+convergence.depends = solver
+bench.depends = solver
@@ -0,0 +1,17 @@
+#-------------------------------------------------
+#
+# Microbenchmarks of the stepping, spectrum, dispersion, profile and view
+# paths over a range of grid sizes, with comparison against a baseline.
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+CONFIG += console c++14
+CONFIG -= app_bundle qt
+
+TARGET = TransportEquation1DBench
+
+SOURCES += \
+        main.cpp
+
+include(../solver/solver.pri)
@@ -0,0 +1,474 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "blocking.h"
+#include "decomposition.h"
+#include "field.h"
+#include "highresolution.h"
+#include "implicit.h"
+#include "kernels.h"
+#include "parameters.h"
+#include "profile.h"
+#include "scheme.h"
+#include "semilagrangian.h"
+#include "spectral.h"
+#include "spectrum.h"
+#include "stability.h"
+#include "view.h"
+
+// Benchmarks the paths behind the GUI (Form::Tick, updateSpectrum,
+// updateDispersionDiffusion, initiateState and showState) without Qt.
+
+typedef std::function<void()> Iteration;
+
+struct Benchmark
+{
+    std::string name;
+    double cells, bytes;            // per iteration
+    // Allocates the state of the benchmark, held by the Iteration it
+    // returns and released with it.
+    std::function<Iteration()> setup;
+};
+
+struct Measurement
+{
+    std::string name;
+    std::int64_t nx;
+    std::int64_t iterations;
+    double seconds;                 // per iteration, best of the repeats
+    double cells, bytes;            // per second
+};
+
+static void usage(const char *name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --nx LIST          comma-separated grid sizes (16,256,4096,65536,1048576,16777216)\n"
+              << "  --filter TEXT      run only benchmarks whose name contains TEXT\n"
+              << "  --isa NAME         scalar, avx2 or avx512 (the widest supported)\n"
+              << "  --min-time S       run each benchmark for at least S seconds (0.2)\n"
+              << "  --repeats N        keep the best of N timings (3)\n"
+              << "  --output FILE      write the results to FILE instead of stdout\n"
+              << "  --baseline FILE    compare with earlier results, exit with 3 on a regression\n"
+              << "  --tolerance F      allowed relative slowdown against the baseline (0.1)\n";
+}
+
+static std::vector<std::string> split(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+static double elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The Gauss profile on the grid, and a second grid to step into. Field
+// has no move, so each is built in place rather than assigned.
+struct Grids
+{
+    Grids(const Parameters &param, std::size_t n, bool pair)
+        : u(n)
+    {
+        fillInitialState(param, Gauss, u.data());
+        u.fillGhosts();
+        if (pair)
+            Field(u).swap(v);
+    }
+
+    Field u, v;
+};
+
+static std::shared_ptr<Grids> makeGrids(const Parameters &param, std::size_t n, bool pair)
+{
+    return std::make_shared<Grids>(param, n, pair);
+}
+
+// Doubles the iteration count until a batch takes min_time, then keeps the
+// fastest of repeats such batches.
+static Measurement measure(const Benchmark &bench, const Iteration &iteration, std::int64_t nx, double min_time,
+                           int repeats)
+{
+    iteration();
+
+    std::int64_t iterations = 1;
+    for (;;)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::int64_t i = 0; i < iterations; ++i)
+            iteration();
+        if (elapsed(start) >= min_time || iterations >= (std::int64_t(1) << 40))
+            break;
+        iterations *= 2;
+    }
+
+    double best = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::int64_t i = 0; i < iterations; ++i)
+            iteration();
+        best = std::min(best, elapsed(start) / iterations);
+    }
+    return Measurement{bench.name, nx, iterations, best, bench.cells / best, bench.bytes / best};
+}
+
+// Traffic is counted as the data a kernel has to stream at least once:
+// reading and writing the grid for a step, reading it for the spectrum, and
+// so on. A blocked sweep does kTileSteps cell updates per cell streamed.
+// Each setup allocates only the state its own benchmark needs, so that a
+// filtered run on a large grid holds no more than that.
+static std::vector<Benchmark> benchmarks(std::int64_t nx)
+{
+    const Parameters param(nx, nx, kRangeX, kRangeT);
+    const double alpha = param.get_alpha();
+    const std::size_t n = static_cast<std::size_t>(nx);
+    const double cells = static_cast<double>(nx);
+    std::vector<Benchmark> list;
+
+    list.push_back(Benchmark{"initial", cells, 8.0 * cells, [param, n] {
+        std::shared_ptr<Grids> g = makeGrids(param, n, false);
+        return Iteration([param, g] {
+            fillInitialState(param, Gauss, g->u.data());
+        });
+    }});
+
+    for (int m = 0; m < kMethodCount; ++m)
+    {
+        MethodType method = static_cast<MethodType>(m);
+        if (isImplicitMethod(method))
+        {
+            // One thread, and one per core with parallel cyclic reduction
+            // from kParallelSolveCells.
+            auto implicit = [param, n, alpha, method](bool periodic, unsigned threads) {
+                return [param, n, alpha, method, periodic, threads] {
+                    std::shared_ptr<Grids> g = makeGrids(param, n, true);
+                    std::shared_ptr<ImplicitScheme> scheme(new ImplicitScheme(n, alpha, method, periodic, threads));
+                    return Iteration([g, scheme] {
+                        scheme->step(g->u.data(), g->v.data());
+                        g->u.swap(g->v);
+                    });
+                };
+            };
+            list.push_back(Benchmark{std::string("step-") + methodName(method), cells, 16.0 * cells,
+                                     implicit(false, 1)});
+            list.push_back(Benchmark{std::string("periodic-") + methodName(method), cells, 16.0 * cells,
+                                     implicit(true, 1)});
+            list.push_back(Benchmark{std::string("threaded-") + methodName(method), cells, 16.0 * cells,
+                                     implicit(false, 0)});
+            continue;
+        }
+        if (isHighResolutionMethod(method))
+        {
+            list.push_back(Benchmark{std::string("step-") + methodName(method), cells, 16.0 * cells,
+                                     [param, n, alpha, method] {
+                std::shared_ptr<Grids> g = makeGrids(param, n, true);
+                std::shared_ptr<HighResolutionScheme> scheme(new HighResolutionScheme(n, alpha, method, false));
+                return Iteration([g, scheme] {
+                    scheme->step(g->u, g->v);
+                    g->u.swap(g->v);
+                });
+            }});
+            continue;
+        }
+        if (isSemiLagrangianMethod(method))
+        {
+            list.push_back(Benchmark{std::string("step-") + methodName(method), cells, 16.0 * cells,
+                                     [param, n, alpha, method] {
+                std::shared_ptr<Grids> g = makeGrids(param, n, true);
+                std::shared_ptr<SemiLagrangianScheme> scheme(new SemiLagrangianScheme(n, alpha, method, false));
+                return Iteration([g, scheme] {
+                    scheme->step(g->u.data(), g->v.data());
+                    g->u.swap(g->v);
+                });
+            }});
+            continue;
+        }
+        if (!isStencilMethod(method))
+        {
+            list.push_back(Benchmark{std::string("step-") + methodName(method), cells, 8.0 * cells, [param, n, alpha] {
+                std::shared_ptr<Grids> g = makeGrids(param, n, false);
+                std::shared_ptr<SpectralPropagator> spectral(new SpectralPropagator(n, alpha));
+                return Iteration([g, spectral] {
+                    spectral->advance(g->u.data(), 1);
+                });
+            }});
+            continue;
+        }
+        Stencil s = stencil(method, alpha);
+        list.push_back(Benchmark{std::string("step-") + methodName(method), cells, 16.0 * cells,
+                                 [param, n, method, s] {
+            std::shared_ptr<Grids> g = makeGrids(param, n, true);
+            return Iteration([g, n, method, s] {
+                sweep(g->u.data(), g->v.data(), n, method, s);
+                g->u.swap(g->v);
+            });
+        }});
+        list.push_back(Benchmark{std::string("fused-") + methodName(method), cells, 16.0 * cells,
+                                 [param, n, method, s] {
+            std::shared_ptr<Grids> g = makeGrids(param, n, true);
+            return Iteration([g, n, method, s] {
+                Reduction r = emptyReduction();
+                sweepReduce(g->u.data(), g->v.data(), 1, n-1, method, s, r);
+                g->u.swap(g->v);
+            });
+        }});
+        list.push_back(Benchmark{std::string("blocked-") + methodName(method), kTileSteps * cells, 16.0 * cells,
+                                 [param, n, method, s] {
+            std::shared_ptr<Grids> g = makeGrids(param, n, true);
+            std::shared_ptr<Field> scratch(new Field), tmp_scratch(new Field);
+            return Iteration([g, scratch, tmp_scratch, method, s] {
+                blockedSweep(g->u, g->v, method, s, kTileSteps, kTileWidth, *scratch, *tmp_scratch);
+                g->u.swap(g->v);
+            });
+        }});
+        // One thread per core; the subdomains keep the state between
+        // iterations, as they do between Solver::advance() calls.
+        list.push_back(Benchmark{std::string("decomposed-") + methodName(method), 4 * kHaloSteps * cells,
+                                 16.0 * 4 * kHaloSteps * cells, [param, n, method, s] {
+            std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(n, method, s, false));
+            decomposition->load(makeGrids(param, n, false)->u.data());
+            return Iteration([decomposition] {
+                std::vector<Reduction> reductions;
+                decomposition->advance(4 * kHaloSteps, reductions);
+            });
+        }});
+    }
+
+    list.push_back(Benchmark{"spectrum", cells, 8.0 * cells, [param] {
+        std::shared_ptr<std::vector<double>> values(new std::vector<double>(initialState(param, Gauss)));
+        std::vector<double> y;
+        return Iteration([values, y]() mutable {
+            std::vector<double> spectrum = amplitudeSpectrum(*values);
+            std::size_t bin = (spectrum.size() + kSpectrumBars - 1) / kSpectrumBars;
+            y.clear();
+            for (std::size_t i = 0; i < spectrum.size(); i += bin)
+                y.push_back(*std::max_element(spectrum.begin() + i, spectrum.begin() + std::min(i + bin, spectrum.size())));
+        });
+    }});
+
+    // The whole map is computed once at start-up, the slices on every change
+    // of the grid; neither depends on nx.
+    const double map_cells = static_cast<double>(kStabilityAlphas * kStabilityWavenumbers * kMethodCount);
+    list.push_back(Benchmark{"stability", map_cells, 16.0 * map_cells, [] {
+        std::shared_ptr<StabilityMap> stability(new StabilityMap);
+        return Iteration([stability] {
+            stability->compute(kStabilityAlphas, kStabilityWavenumbers, kStabilityAlphaMax);
+        });
+    }});
+
+    const double points = static_cast<double>(kStabilityWavenumbers * kMethodCount);
+    list.push_back(Benchmark{"dispersion", points, 64.0 * points, [alpha] {
+        std::shared_ptr<StabilityMap> stability(new StabilityMap);
+        stability->compute(kStabilityAlphas, kStabilityWavenumbers, kStabilityAlphaMax);
+        std::vector<double> x, y;
+        return Iteration([alpha, stability, x, y]() mutable {
+            for (int m = 0; m < kMethodCount; ++m)
+                stability->slice(static_cast<MethodType>(m), std::min(alpha, kStabilityAlphaMax), x, y);
+        });
+    }});
+
+    // Envelope of a snapshot plus its redraw at a typical plot width.
+    list.push_back(Benchmark{"view", cells, 8.0 * cells, [param, n] {
+        std::shared_ptr<Grids> g = makeGrids(param, n, false);
+        std::vector<double> x, y;
+        return Iteration([g, n, param, x, y]() mutable {
+            Envelope envelope;
+            reduceEnvelope(g->u.data(), n, param.get_dx(), kViewPoints, envelope);
+            envelopePolyline(envelope, envelope.x_begin, envelope.x_end, 1024, x, y);
+        });
+    }});
+
+    return list;
+}
+
+static std::string key(const std::string &name, std::int64_t nx)
+{
+    return name + "/" + std::to_string(nx);
+}
+
+static void writeResults(std::ostream &out, const std::vector<Measurement> &results)
+{
+    out.precision(6);
+    out << "benchmark\tnx\tisa\titerations\tseconds\tcells_per_s\tbytes_per_s\n";
+    for (const auto &result: results)
+    {
+        out << result.name << "\t" << result.nx << "\t" << kernelIsaName(kernelIsa()) << "\t"
+            << result.iterations << "\t" << result.seconds << "\t"
+            << result.cells << "\t" << result.bytes << "\n";
+    }
+}
+
+// Baseline cells/s by benchmark and nx, from an earlier results table.
+static bool readBaseline(const std::string &path, std::map<std::string, double> *baseline)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line))
+    {
+        std::stringstream row(line);
+        std::string name, isa;
+        std::int64_t nx, iterations;
+        double seconds, cells_per_s;
+        if (row >> name >> nx >> isa >> iterations >> seconds >> cells_per_s)
+            (*baseline)[key(name, nx)] = cells_per_s;
+    }
+    return true;
+}
+
+static bool compareBaseline(const std::vector<Measurement> &results, const std::map<std::string, double> &baseline,
+                            double tolerance)
+{
+    bool regression = false;
+    for (const auto &result: results)
+    {
+        auto it = baseline.find(key(result.name, result.nx));
+        if (it == baseline.end())
+            continue;
+        double ratio = result.cells / it->second;
+        bool slower = ratio < 1.0 - tolerance;
+        regression = regression || slower;
+        std::cerr << result.name << "\t" << result.nx << "\t" << ratio << (slower ? "\tREGRESSION" : "") << "\n";
+    }
+    return !regression;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::int64_t> nxs = {16, 256, 4096, 65536, 1048576, 16777216};
+    std::string filter, output, baseline_path;
+    double min_time = 0.2, tolerance = 0.1;
+    int repeats = 3;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+        {
+            usage(argv[0]);
+            return 0;
+        }
+        if (i+1 >= argc)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        bool ok = true;
+        if (arg == "--nx")
+        {
+            nxs.clear();
+            for (const auto &item: split(value))
+            {
+                nxs.push_back(std::atoll(item.c_str()));
+                ok = ok && nxs.back() >= 3;
+            }
+            ok = ok && !nxs.empty();
+        }
+        else if (arg == "--filter")
+            filter = value;
+        else if (arg == "--isa")
+        {
+            if (value == "scalar")
+                setKernelIsa(IsaScalar);
+            else if (value == "avx2")
+                setKernelIsa(IsaAvx2);
+            else if (value == "avx512")
+                setKernelIsa(IsaAvx512);
+            else
+                ok = false;
+        }
+        else if (arg == "--min-time")
+        {
+            min_time = std::atof(value.c_str());
+            ok = min_time > 0.0;
+        }
+        else if (arg == "--repeats")
+        {
+            repeats = std::atoi(value.c_str());
+            ok = repeats >= 1;
+        }
+        else if (arg == "--output")
+            output = value;
+        else if (arg == "--baseline")
+            baseline_path = value;
+        else if (arg == "--tolerance")
+        {
+            tolerance = std::atof(value.c_str());
+            ok = tolerance >= 0.0;
+        }
+        else
+            ok = false;
+        if (!ok)
+        {
+            std::cerr << "Invalid option " << arg << " " << value << "\n";
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baseline_path.empty() && !readBaseline(baseline_path, &baseline))
+    {
+        std::cerr << "Cannot open " << baseline_path << "\n";
+        return 1;
+    }
+
+    std::vector<Measurement> results;
+    try
+    {
+        for (auto nx: nxs)
+        {
+            for (const auto &bench: benchmarks(nx))
+            {
+                if (bench.name.find(filter) == std::string::npos)
+                    continue;
+                results.push_back(measure(bench, bench.setup(), nx, min_time, repeats));
+                std::cerr << bench.name << " nx=" << nx << "\n";
+            }
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        std::cerr << "Not enough memory for the requested grids\n";
+        return 1;
+    }
+
+    if (output.empty())
+        writeResults(std::cout, results);
+    else
+    {
+        std::ofstream out(output);
+        if (!out)
+        {
+            std::cerr << "Cannot open " << output << "\n";
+            return 1;
+        }
+        writeResults(out, results);
+    }
+
+    if (!baseline.empty() && !compareBaseline(results, baseline, tolerance))
+        return 3;
+    return 0;
+}
@@ -0,0 +1,16 @@
+#-------------------------------------------------
+#
+# Command-line front end: runs one configuration to kRangeT without a display.
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+CONFIG += console c++14
+CONFIG -= app_bundle qt
+
+TARGET = TransportEquation1DCli
+
+SOURCES += \
+        main.cpp
+
+include(../solver/solver.pri)
@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <iostream>
+#include <string>
+
+#include "amr.h"
+#include "exporter.h"
+#include "history.h"
+#include "output.h"
+#include "solver.h"
+#include "spectrum.h"
+#include "trace.h"
+
+static void usage(const char *name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --profile gauss|supergauss|rectangle|step   initial pulse (gauss)\n"
+              << "  --method NAME                               upwind, lax, lax-wendroff, spectral, backward-euler,\n"
+              << "                                              crank-nicolson, semi-lagrangian-linear,\n"
+              << "                                              semi-lagrangian-cubic, semi-lagrangian-monotone,\n"
+              << "                                              muscl-minmod, muscl-superbee, muscl-van-leer or\n"
+              << "                                              weno5 (upwind)\n"
+              << "  --nx N                                      number of spatial points (129)\n"
+              << "  --nt N                                      number of time steps (100)\n"
+              << "  --sweep naive|blocked|fourier               one pass per step, temporal blocking or an exact\n"
+              << "                                              periodic jump in Fourier space (blocked)\n"
+              << "  --boundary fixed|periodic                   boundaries of the stencil and implicit schemes (fixed)\n"
+              << "  --active-region on|off                      skip the quiescent parts of the grid (on)\n"
+              << "  --threads N                                 threads for one stencil run of at least 2^18 points,\n"
+              << "                                              0 for one per core (1)\n"
+              << "  --amr LEVELS                                refine adaptively by LEVELS levels up to the nx, nt\n"
+              << "                                              grid (upwind, lax-wendroff and muscl-*; 0, off)\n"
+              << "  --wisdom FILE                               load FFTW wisdom from FILE and save it back\n"
+              << "  --trace FILE                                write a Chrome trace to FILE (tracing builds)\n"
+              << "  --diagnostics FILE                          write the per-step diagnostics to FILE\n"
+              << "  --export FILE                               export snapshots, diagnostics and parameters to FILE\n"
+              << "  --export-format binary|csv                  columnar binary or CSV (binary)\n"
+              << "  --export-every K                            export every K-th step (nt/100)\n"
+              << "  --history FILE                              write every recorded step of the grid to FILE\n"
+              << "  --history-stride K                          record every K-th step (keeps FILE under 4 GiB)\n"
+              << "  --every K                                   write only every K-th point (1)\n"
+              << "  --output FILE                               write solution to FILE instead of stdout\n";
+}
+
+static bool writeTo(const std::string &path, const std::function<void(std::ostream&)> &write)
+{
+    if (path.empty())
+    {
+        write(std::cout);
+        return true;
+    }
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Cannot open " << path << "\n";
+        return false;
+    }
+    write(out);
+    return true;
+}
+
+// param is the finest grid; the base grid has 2^levels times fewer cells
+// and steps.
+static int runAmr(const Parameters &param, InitialProfile profile, MethodType method, int levels,
+                  std::int64_t every, const std::string &output, const std::string &diagnostics,
+                  bool unsupported)
+{
+    const std::int64_t ratio = std::int64_t(1) << std::min(std::max(levels, 0), 30);
+    const std::int64_t cells = param.get_nx() - 1;
+    if (levels < 0 || levels > 30 || cells % ratio != 0 || param.get_nt() % ratio != 0 || cells / ratio < 2)
+    {
+        std::cerr << "--amr LEVELS needs nx - 1 and nt divisible by 2^LEVELS, with at least 2 base cells\n";
+        return 1;
+    }
+    if (!isAmrMethod(method) || unsupported)
+    {
+        std::cerr << "--amr supports upwind, lax-wendroff and muscl-* with fixed boundaries,"
+                     " without --sweep fourier, --history or --export\n";
+        return 1;
+    }
+
+    AmrSettings settings;
+    settings.levels = levels;
+    AmrSolver solver(Parameters(cells / ratio + 1, param.get_nt() / ratio, kRangeX, kRangeT),
+                     profile, method, settings);
+    solver.run();
+
+    int result = solver.diverged() ? 2 : 0;
+    if (!writeTo(output, [&](std::ostream &out) { writeAmrSolution(out, solver, every); }))
+        result = 1;
+    if (!diagnostics.empty() &&
+        !writeTo(diagnostics, [&](std::ostream &out) { writeDiagnostics(out, solver.diagnostics()); }))
+        result = 1;
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    InitialProfile profile = Gauss;
+    MethodType method = Upwind;
+    std::int64_t nx = 129;
+    std::int64_t nt = 100;
+    std::int64_t every = 1;
+    std::int64_t history_stride = 0;
+    std::int64_t export_stride = 0;
+    int amr_levels = 0;
+    ExportFormat export_format = ExportBinary;
+    bool blocking = true;
+    bool fourier = false;
+    bool periodic = false;
+    bool active_region = true;
+    std::int64_t threads = 1;
+    std::string wisdom;
+    std::string trace;
+    std::string diagnostics;
+    std::string history;
+    std::string export_path;
+    std::string output;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+        {
+            usage(argv[0]);
+            return 0;
+        }
+        if (i+1 >= argc)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--profile" && profileFromName(value, &profile))
+            continue;
+        if (arg == "--method" && methodFromName(value, &method))
+            continue;
+        if (arg == "--nx")
+        {
+            nx = std::atoll(value.c_str());
+            continue;
+        }
+        if (arg == "--nt")
+        {
+            nt = std::atoll(value.c_str());
+            continue;
+        }
+        if (arg == "--every")
+        {
+            every = std::atoll(value.c_str());
+            continue;
+        }
+        if (arg == "--sweep" && (value == "naive" || value == "blocked" || value == "fourier"))
+        {
+            blocking = value == "blocked";
+            fourier = value == "fourier";
+            continue;
+        }
+        if (arg == "--boundary" && (value == "fixed" || value == "periodic"))
+        {
+            periodic = value == "periodic";
+            continue;
+        }
+        if (arg == "--active-region" && (value == "on" || value == "off"))
+        {
+            active_region = value == "on";
+            continue;
+        }
+        if (arg == "--threads")
+        {
+            threads = std::atoll(value.c_str());
+            continue;
+        }
+        if (arg == "--amr")
+        {
+            amr_levels = std::atoi(value.c_str());
+            continue;
+        }
+        if (arg == "--wisdom")
+        {
+            wisdom = value;
+            continue;
+        }
+        if (arg == "--diagnostics")
+        {
+            diagnostics = value;
+            continue;
+        }
+        if (arg == "--export")
+        {
+            export_path = value;
+            continue;
+        }
+        if (arg == "--export-format" && exportFormatFromName(value, &export_format))
+            continue;
+        if (arg == "--export-every")
+        {
+            export_stride = std::atoll(value.c_str());
+            continue;
+        }
+        if (arg == "--history")
+        {
+            history = value;
+            continue;
+        }
+        if (arg == "--history-stride")
+        {
+            history_stride = std::atoll(value.c_str());
+            continue;
+        }
+        if (arg == "--trace")
+        {
+            trace = value;
+            continue;
+        }
+        if (arg == "--output")
+        {
+            output = value;
+            continue;
+        }
+        std::cerr << "Invalid option " << arg << " " << value << "\n";
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (nx < 3 || nt < 1 || every < 1 || history_stride < 0 || export_stride < 0 || threads < 0)
+    {
+        std::cerr << "nx must be at least 3, nt and every at least 1, the strides and threads not negative\n";
+        return 1;
+    }
+
+    if (amr_levels != 0)
+        return runAmr(Parameters(nx, nt, kRangeX, kRangeT), profile, method, amr_levels,
+                      every, output, diagnostics,
+                      periodic || fourier || !history.empty() || !export_path.empty());
+
+    // Solver::setFourierPropagation() leaves the other methods stepping.
+    if (fourier && !isLinearMethod(method))
+    {
+        std::cerr << "--sweep fourier needs a linear method, not " << methodName(method) << "\n";
+        return 1;
+    }
+
+    if (!wisdom.empty())
+    {
+        loadFftWisdom(wisdom);
+        setFftEffort(FftMeasure);
+    }
+
+    Solver *solver = nullptr;
+    try
+    {
+        solver = new Solver(Parameters(nx, nt, kRangeX, kRangeT), profile, method);
+    }
+    catch (const std::bad_alloc&)
+    {
+        std::cerr << "Not enough memory for " << nx << " points\n";
+        return 1;
+    }
+    solver->setTemporalBlocking(blocking);
+    solver->setPeriodicBoundaries(periodic);
+    solver->setActiveRegion(active_region);
+    solver->setThreads(static_cast<unsigned>(threads));
+    solver->setFourierPropagation(fourier || method == Spectral);
+
+    int result = 0;
+    HistoryWriter writer;
+    if (!history.empty() &&
+        !writer.open(history, solver->parameters(), history_stride > 0 ? history_stride : historyStride(nx, nt)))
+    {
+        std::cerr << "Cannot open " << history << "\n";
+        result = 1;
+    }
+    // A batch run waits for the export rather than dropping snapshots.
+    Exporter exporter;
+    if (!export_path.empty() &&
+        !exporter.open(export_path, export_format, *solver, export_stride > 0 ? export_stride : exportStride(nt), true))
+    {
+        std::cerr << "Cannot open " << export_path << "\n";
+        result = 1;
+    }
+    if (writer.isOpen() || exporter.isOpen())
+    {
+        // Never past the next recorded step; the last state is always kept.
+        writer.append(*solver, true);
+        exporter.append(*solver, true);
+        while (!solver->finished() && !solver->diverged())
+        {
+            std::int64_t next = nt;
+            if (writer.isOpen())
+                next = std::min(next, writer.nextStep(solver->steps()));
+            if (exporter.isOpen())
+                next = std::min(next, exporter.nextStep(solver->steps()));
+            solver->advance(next - solver->steps());
+            bool last = solver->finished() || solver->diverged();
+            if (!writer.append(*solver, last))
+            {
+                std::cerr << "Cannot write to " << history << "\n";
+                result = 1;
+                writer.close();
+            }
+            exporter.append(*solver, last);
+        }
+        writer.close();
+        if (exporter.isOpen() && !exporter.finish(solver->diagnostics()))
+        {
+            std::cerr << "Cannot write to " << export_path << "\n";
+            result = 1;
+        }
+    }
+    else
+    {
+        solver->run();
+    }
+
+    if (solver->diverged())
+        result = 2;
+
+    if (output.empty())
+    {
+        writeSolution(std::cout, *solver, every);
+    }
+    else
+    {
+        std::ofstream out(output);
+        if (!out)
+        {
+            std::cerr << "Cannot open " << output << "\n";
+            result = 1;
+        }
+        else
+        {
+            writeSolution(out, *solver, every);
+        }
+    }
+
+    if (!diagnostics.empty())
+    {
+        std::ofstream out(diagnostics);
+        if (!out)
+        {
+            std::cerr << "Cannot open " << diagnostics << "\n";
+            result = 1;
+        }
+        else
+        {
+            writeDiagnostics(out, solver->diagnostics());
+        }
+    }
+
+    delete solver;
+
+    if (!wisdom.empty() && !saveFftWisdom(wisdom))
+        std::cerr << "Cannot save FFTW wisdom to " << wisdom << "\n";
+
+    if (!trace.empty() && !writeChromeTrace(trace))
+        std::cerr << (kTracing ? "Cannot write the trace to " + trace : std::string("Built without tracing")) << "\n";
+
+    return result;
+}
@@ -0,0 +1,17 @@
+#-------------------------------------------------
+#
+# Convergence harness: runs every profile and method on a ladder of refined
+# grids and reports the error, observed order and work-precision.
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+CONFIG += console c++14 thread
+CONFIG -= app_bundle qt
+
+TARGET = TransportEquation1DConvergence
+
+SOURCES += \
+        main.cpp
+
+include(../solver/solver.pri)
@@ -0,0 +1,168 @@
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "convergence.h"
+
+static void usage(const char *name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --profiles LIST    comma-separated profiles or all (all)\n"
+              << "  --methods LIST     comma-separated methods or all (all)\n"
+              << "  --nx N             spatial points on the coarsest grid (101)\n"
+              << "  --nt N             time steps on the coarsest grid (100)\n"
+              << "  --levels N         number of grids, each twice as fine as the last (5)\n"
+              << "  --repeats N        time each run as the best of N (1)\n"
+              << "  --target E         L2 error for the work-precision summary (1e-3)\n"
+              << "  --threads N        worker threads, 0 for one per core (1)\n"
+              << "  --output FILE      write the tables to FILE instead of stdout\n";
+}
+
+static std::vector<std::string> split(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+static bool parseProfiles(const std::string &list, std::vector<InitialProfile> *profiles)
+{
+    profiles->clear();
+    if (list == "all")
+    {
+        *profiles = allProfiles();
+        return true;
+    }
+    for (const auto &item: split(list))
+    {
+        InitialProfile profile;
+        if (!profileFromName(item, &profile))
+            return false;
+        profiles->push_back(profile);
+    }
+    return !profiles->empty();
+}
+
+static bool parseMethods(const std::string &list, std::vector<MethodType> *methods)
+{
+    methods->clear();
+    if (list == "all")
+    {
+        *methods = allMethods();
+        return true;
+    }
+    for (const auto &item: split(list))
+    {
+        MethodType method;
+        if (!methodFromName(item, &method))
+            return false;
+        methods->push_back(method);
+    }
+    return !methods->empty();
+}
+
+static void writeReport(std::ostream &out, const std::vector<ConvergenceResult> &results, double target)
+{
+    writeConvergenceTable(out, results);
+    out << "\n";
+    writeWorkPrecision(out, results, target);
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<InitialProfile> profiles = allProfiles();
+    std::vector<MethodType> methods = allMethods();
+    std::int64_t nx = 101, nt = 100;
+    int levels = 5, repeats = 1;
+    double target = 1e-3;
+    unsigned threads = 1;
+    std::string output;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+        {
+            usage(argv[0]);
+            return 0;
+        }
+        if (i+1 >= argc)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        bool ok = false;
+        if (arg == "--profiles")
+            ok = parseProfiles(value, &profiles);
+        else if (arg == "--methods")
+            ok = parseMethods(value, &methods);
+        else if (arg == "--nx")
+        {
+            nx = std::atoll(value.c_str());
+            ok = nx >= 3;
+        }
+        else if (arg == "--nt")
+        {
+            nt = std::atoll(value.c_str());
+            ok = nt >= 1;
+        }
+        else if (arg == "--levels")
+        {
+            levels = std::atoi(value.c_str());
+            ok = levels >= 1 && levels <= 20;
+        }
+        else if (arg == "--repeats")
+        {
+            repeats = std::atoi(value.c_str());
+            ok = repeats >= 1;
+        }
+        else if (arg == "--target")
+        {
+            target = std::atof(value.c_str());
+            ok = target > 0.0;
+        }
+        else if (arg == "--threads")
+        {
+            threads = static_cast<unsigned>(std::atoi(value.c_str()));
+            ok = true;
+        }
+        else if (arg == "--output")
+        {
+            output = value;
+            ok = true;
+        }
+        if (!ok)
+        {
+            std::cerr << "Invalid option " << arg << " " << value << "\n";
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<SweepCase> cases = refinementLadder(profiles, methods, nx, nt, levels);
+    std::vector<ConvergenceResult> results = runConvergence(cases, threads, repeats);
+
+    if (output.empty())
+    {
+        writeReport(std::cout, results, target);
+        return 0;
+    }
+
+    std::ofstream out(output);
+    if (!out)
+    {
+        std::cerr << "Cannot open " << output << "\n";
+        return 1;
+    }
+    writeReport(out, results, target);
+    return 0;
+}
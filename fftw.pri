@@ -0,0 +1,9 @@
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+# The bundled Windows DLL includes the threads API; elsewhere it is a
+# separate library.
+DEFINES += HAVE_FFTW_THREADS
+
+win32: LIBS += "$$PWD/libfftw3-3.dll"
+else: LIBS += -lfftw3_threads -lfftw3
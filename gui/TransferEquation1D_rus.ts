@@ -0,0 +1,271 @@
+<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="ru_RU" sourcelanguage="en_US">
+<context>
+    <name>Form</name>
+    <message>
+        <location filename="form.cpp" line="47"/>
+        <source>Initial profile</source>
+        <translation>Начальный профиль импульса</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="68"/>
+        <source>Pulse form</source>
+        <translation>Форма импульса</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="70"/>
+        <source>Gauss</source>
+        <translation>Гаусс</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="71"/>
+        <source>SuperGauss</source>
+        <translation>Супергаусс</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="72"/>
+        <source>Rectangle</source>
+        <translation>Прямоугольник</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="73"/>
+        <source>Step</source>
+        <translation>Ступенька</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="75"/>
+        <source>Grid size</source>
+        <translation>Размер сетки</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="76"/>
+        <source> L = </source>
+        <translation> L = </translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="78"/>
+        <source>Integration time</source>
+        <translation>Время интегрирования</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="79"/>
+        <source> T = </source>
+        <translation> T = </translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="81"/>
+        <source>Number of spatial points</source>
+        <translation>Количество точек по пространству</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="82"/>
+        <source>NX = </source>
+        <translation>NX = </translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="84"/>
+        <source>Number of temporal points</source>
+        <translation>Количество точек по времени</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="85"/>
+        <source>NT = </source>
+        <translation>NT = </translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="117"/>
+        <source>Spatial step</source>
+        <translation>Шаг по пространству</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="118"/>
+        <source>dx = </source>
+        <translation>dx = </translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="122"/>
+        <source>Time step</source>
+        <translation>Шаг по времени</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="123"/>
+        <source>dt = </source>
+        <translation>dt = </translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="127"/>
+        <source>CFL number</source>
+        <translation>Число CFL</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="128"/>
+        <source>α = </source>
+        <oldsource>CFL = </oldsource>
+        <translation>α = </translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="203"/>
+        <source>max u</source>
+        <translation>макс. u</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="205"/>
+        <source>min u</source>
+        <translation>мин. u</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="211"/>
+        <source>TV / TV₀</source>
+        <translation>вариация / вариация₀</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="238"/>
+        <source>Record</source>
+        <translation>Записывать</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="471"/>
+        <source>Amplitude error per step</source>
+        <translation>Ошибка амплитуды за шаг</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="134"/>
+        <source>Periodic, in Fourier space</source>
+        <translation>Периодически, в пространстве Фурье</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="137"/>
+        <source>Start and export...</source>
+        <translation>Старт с экспортом...</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="777"/>
+        <location filename="form.cpp" line="842"/>
+        <location filename="form.cpp" line="844"/>
+        <location filename="form.cpp" line="851"/>
+        <source>Export</source>
+        <translation>Экспорт</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="777"/>
+        <source>Cannot open %1</source>
+        <translation>Не удаётся открыть %1</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="842"/>
+        <source>The export could not be written completely</source>
+        <translation>Экспорт записан не полностью</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="844"/>
+        <source>%1 snapshots were skipped to keep up with the solver</source>
+        <translation>Пропущено снимков, чтобы не задерживать расчёт: %1</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="852"/>
+        <source>Columnar binary (*.bin);;CSV (*.csv)</source>
+        <translation>Двоичный по столбцам (*.bin);;CSV (*.csv)</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="136"/>
+        <source>Start</source>
+        <translation>Старт</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="357"/>
+        <source>Dispersion error</source>
+        <translation>Дисперсия</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="395"/>
+        <source>Dissipation error</source>
+        <translation>Диссипация</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="430"/>
+        <source>Solution</source>
+        <translation>Решение</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="142"/>
+        <source>Upwind</source>
+        <translation>Схема бегущего счета</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="143"/>
+        <source>Lax-Friedrichs</source>
+        <translation>Схема Лакса-Фридрихса</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="144"/>
+        <source>Lax-Wendroff</source>
+        <translation>Схема Лакса-Вендроффа</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="145"/>
+        <source>Pseudo-spectral</source>
+        <translation>Псевдоспектральный метод</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="146"/>
+        <source>Backward Euler</source>
+        <translation>Неявная схема Эйлера</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="147"/>
+        <source>Crank-Nicolson</source>
+        <translation>Схема Кранка-Николсон</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="148"/>
+        <source>Semi-Lagrangian, linear</source>
+        <translation>Полулагранжева схема, линейная</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="149"/>
+        <source>Semi-Lagrangian, cubic</source>
+        <translation>Полулагранжева схема, кубическая</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="150"/>
+        <source>Semi-Lagrangian, monotone cubic</source>
+        <translation>Полулагранжева схема, монотонная кубическая</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="151"/>
+        <source>MUSCL, minmod</source>
+        <translation>MUSCL, ограничитель minmod</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="152"/>
+        <source>MUSCL, superbee</source>
+        <translation>MUSCL, ограничитель superbee</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="153"/>
+        <source>MUSCL, van Leer</source>
+        <translation>MUSCL, ограничитель ван Лира</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="154"/>
+        <source>WENO5</source>
+        <translation>WENO5</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="187"/>
+        <source>Diagnostics</source>
+        <translation>Диагностика</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="207"/>
+        <source>mass / mass₀</source>
+        <translation>масса / масса₀</translation>
+    </message>
+    <message>
+        <location filename="form.cpp" line="209"/>
+        <source>energy / energy₀</source>
+        <translation>энергия / энергия₀</translation>
+    </message>
+</context>
+</TS>
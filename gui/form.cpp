@@ -0,0 +1,996 @@
+#include "form.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileDialog>
+#include <QLayout>
+#include <QMessageBox>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "view.h"
+
+static void setGrid(QValueAxis* ax)
+{
+    ax->setGridLineVisible(true);
+    QPen pen = ax->gridLinePen();
+    pen.setWidth(2);
+    pen.setColor(Qt::gray);
+    ax->setGridLinePen(pen);
+}
+
+Form::Form(QWidget *parent)
+    : QWidget(parent), param(kNxMin+1, kNtMin, kRangeX, kRangeT), method_(Upwind), solver_(nullptr),
+      solverThread_(nullptr), milestonesShown_(0)
+{
+    timer = new QTimer();
+    timer->setInterval(16);
+
+    // Dragging a slider only restarts previewTimer; the initial state and
+    // its spectrum are recomputed in the background once it fires.
+    previewTimer = new QTimer();
+    previewTimer->setSingleShot(true);
+    previewTimer->setInterval(kPreviewDelay);
+    previewThread_ = new PreviewThread();
+
+    seriesInitial = new QLineSeries();
+    seriesInitial->setColor(Qt::blue);
+    seriesInitial->setPen(QPen(seriesInitial->pen().brush(), 3));
+
+    QChart *chartInitial = new QChart();
+    chartInitial->addSeries(seriesInitial);
+    chartInitial->setTitle(tr("Initial profile"));
+    chartInitial->legend()->hide();
+
+    QValueAxis *axisXInitial = new QValueAxis;
+    axisXInitial->setLineVisible(false);
+    setGrid(axisXInitial);
+    axisXInitial->setLabelsVisible(false);
+    axisXInitial->setRange(0.0, kRangeX/2);
+    chartInitial->addAxis(axisXInitial, Qt::AlignBottom);
+    seriesInitial->attachAxis(axisXInitial);
+    QValueAxis *axisYInitial = new QValueAxis;
+    axisYInitial->setLineVisible(false);
+    setGrid(axisYInitial);
+    axisYInitial->setLabelsVisible(false);
+    axisYInitial->setRange(0.0, 1.003);
+    chartInitial->addAxis(axisYInitial, Qt::AlignLeft);
+    seriesInitial->attachAxis(axisYInitial);
+
+    chartView = new QChartView(chartInitial);
+    chartView->setRenderHint(QPainter::Antialiasing);
+
+    labelInitial = new QLabel(tr("Pulse form"));
+    comboBoxInitial = new QComboBox();
+    comboBoxInitial->addItem(tr("Gauss"), QVariant(Gauss));
+    comboBoxInitial->addItem(tr("SuperGauss"), QVariant(SuperGauss));
+    comboBoxInitial->addItem(tr("Rectangle"), QVariant(Rectangle));
+    comboBoxInitial->addItem(tr("Step"), QVariant(Step));
+
+    labelSizeX_1 = new QLabel(tr("Grid size"));
+    labelSizeX_2 = new QLabel(tr(" L = "));
+    labelSizeX_2->setAlignment(Qt::AlignRight);
+    labelSizeT_1 = new QLabel(tr("Integration time"));
+    labelSizeT_2 = new QLabel(tr(" T = "));
+    labelSizeT_2->setAlignment(Qt::AlignRight);
+    labelNX_1 = new QLabel(tr("Number of spatial points"));
+    labelNX_2 = new QLabel(tr("NX = "));
+    labelNX_2->setAlignment(Qt::AlignRight);
+    labelNT_1 = new QLabel(tr("Number of temporal points"));
+    labelNT_2 = new QLabel(tr("NT = "));
+    labelNT_2->setAlignment(Qt::AlignRight);
+
+    labelSizeX = new QLabel(QString::number(kRangeX, 'f', 1));
+    labelSizeT = new QLabel(QString::number(kRangeT, 'f', 1));
+
+    sliderNX = new QSlider(Qt::Horizontal);
+    sliderNX->setRange(1, static_cast<int>(std::round(std::log2(kNxMax))) - 3);
+    sliderNX->setSingleStep(1);
+    sliderNX->setPageStep(1);
+    sliderNX->setTickInterval(1);
+    sliderNX->setTickPosition(QSlider::TicksBelow);
+    sliderNX->setValue(1);
+
+    sliderNT = new QSlider(Qt::Horizontal);
+    sliderNT->setRange(kNtMin, kNtMax);
+    sliderNT->setTickInterval(kNtMax / 10);
+    sliderNT->setTickPosition(QSlider::TicksBelow);
+    sliderNT->setValue(kNtMin);
+
+    spinBoxNX = new QSpinBox();
+    spinBoxNX->setMinimum(0);
+    spinBoxNX->setMaximum(kNxMax);
+    spinBoxNX->setValue(kNxMin);
+    spinBoxNX->setSingleStep(kNxMin);
+
+    spinBoxNT = new QSpinBox();
+    spinBoxNT->setMinimum(kNtMin);
+    spinBoxNT->setMaximum(kNtMax);
+    spinBoxNT->setValue(kNtMin);
+    spinBoxNT->setSingleStep(1);
+
+    labelStepX_1 = new QLabel(tr("Spatial step"));
+    labelStepX_2 = new QLabel(tr("dx = "));
+    labelStepX_2->setAlignment(Qt::AlignRight);
+    labelStepX = new QLabel();
+
+    labelStepT_1 = new QLabel(tr("Time step"));
+    labelStepT_2 = new QLabel(tr("dt = "));
+    labelStepT_2->setAlignment(Qt::AlignRight);
+    labelStepT = new QLabel();
+
+    labelCFL_1 = new QLabel(tr("CFL number"));
+    labelCFL_2 = new QLabel(tr("α = "));
+    labelCFL_2->setFont(QFont("Times New Roman", 14));
+    labelCFL_2->setAlignment(Qt::AlignRight);
+    labelCFL = new QLabel();
+
+    // Exact periodic solution at any time instead of stepping the scheme.
+    checkBoxFourier = new QCheckBox(tr("Periodic, in Fourier space"));
+
+    pushButtonSolve = new QPushButton(tr("Start"));
+    pushButtonExport = new QPushButton(tr("Start and export..."));
+
+    stabilityMap_.compute(kStabilityAlphas, kStabilityWavenumbers, kStabilityAlphaMax);
+
+    tabWidgetMethods = new QTabWidget();
+    addMethodTab(Upwind, tr("Upwind"));
+    addMethodTab(Lax, tr("Lax-Friedrichs"));
+    addMethodTab(LaxWendroff, tr("Lax-Wendroff"));
+    addMethodTab(Spectral, tr("Pseudo-spectral"));
+    addMethodTab(BackwardEuler, tr("Backward Euler"));
+    addMethodTab(CrankNicolson, tr("Crank-Nicolson"));
+    addMethodTab(SemiLagrangianLinear, tr("Semi-Lagrangian, linear"));
+    addMethodTab(SemiLagrangianCubic, tr("Semi-Lagrangian, cubic"));
+    addMethodTab(SemiLagrangianMonotone, tr("Semi-Lagrangian, monotone cubic"));
+    addMethodTab(MusclMinmod, tr("MUSCL, minmod"));
+    addMethodTab(MusclSuperbee, tr("MUSCL, superbee"));
+    addMethodTab(MusclVanLeer, tr("MUSCL, van Leer"));
+    addMethodTab(Weno5, tr("WENO5"));
+
+    QGridLayout *layoutNxNt = new QGridLayout();
+    layoutNxNt->addWidget(labelInitial, 0, 0, 1, 1);
+    layoutNxNt->addWidget(comboBoxInitial, 0, 1, 1, 3);
+    layoutNxNt->addWidget(labelSizeX_1, 1, 0, 1, 1);
+    layoutNxNt->addWidget(labelSizeX_2, 1, 1, 1, 1);
+    layoutNxNt->addWidget(labelSizeX, 1, 2, 1, 1);
+    layoutNxNt->addWidget(labelSizeT_1, 2, 0, 1, 1);
+    layoutNxNt->addWidget(labelSizeT_2, 2, 1, 1, 1);
+    layoutNxNt->addWidget(labelSizeT, 2, 2, 1, 1);
+    layoutNxNt->addWidget(labelNX_1, 3, 0, 1, 1, Qt::AlignBaseline);
+    layoutNxNt->addWidget(labelNX_2, 3, 1, 1, 1, Qt::AlignBaseline);
+    layoutNxNt->addWidget(spinBoxNX, 3, 2, 1, 1);
+    layoutNxNt->addWidget(sliderNX, 3, 3, 1, 1);
+    layoutNxNt->addWidget(labelNT_1, 4, 0, 1, 1, Qt::AlignBaseline);
+    layoutNxNt->addWidget(labelNT_2, 4, 1, 1, 1, Qt::AlignBaseline);
+    layoutNxNt->addWidget(spinBoxNT, 4, 2, 1, 1);
+    layoutNxNt->addWidget(sliderNT, 4, 3, 1, 1);
+    layoutNxNt->addWidget(labelStepX_1, 5, 0, 1, 1);
+    layoutNxNt->addWidget(labelStepX_2, 5, 1, 1, 1);
+    layoutNxNt->addWidget(labelStepX, 5, 2, 1, 1);
+    layoutNxNt->addWidget(labelStepT_1, 6, 0, 1, 1);
+    layoutNxNt->addWidget(labelStepT_2, 6, 1, 1, 1);
+    layoutNxNt->addWidget(labelStepT, 6, 2, 1, 1);
+    layoutNxNt->addWidget(labelCFL_1, 7, 0, 1, 1);
+    layoutNxNt->addWidget(labelCFL_2, 7, 1, 1, 1);
+    layoutNxNt->addWidget(labelCFL, 7, 2, 1, 1);
+    layoutNxNt->addWidget(checkBoxFourier, 5, 3, 1, 1);
+    layoutNxNt->addWidget(pushButtonSolve, 6, 3, 1, 1);
+    layoutNxNt->addWidget(pushButtonExport, 7, 3, 1, 1);
+
+    QChart *chartDiagnostics = new QChart();
+    chartDiagnostics->setTitle(tr("Diagnostics"));
+    chartDiagnostics->legend()->setAlignment(Qt::AlignBottom);
+    QValueAxis *axisXDiagnostics = new QValueAxis;
+    axisXDiagnostics->setLineVisible(false);
+    setGrid(axisXDiagnostics);
+    axisXDiagnostics->setTitleText("t");
+    axisXDiagnostics->setTitleFont(QFont("Times New Roman", 14));
+    axisXDiagnostics->setRange(0.0, kRangeT);
+    chartDiagnostics->addAxis(axisXDiagnostics, Qt::AlignBottom);
+    QValueAxis *axisYDiagnostics = new QValueAxis;
+    axisYDiagnostics->setLineVisible(false);
+    setGrid(axisYDiagnostics);
+    axisYDiagnostics->setTickCount(3);
+    axisYDiagnostics->setRange(-0.5, 2.0);
+    chartDiagnostics->addAxis(axisYDiagnostics, Qt::AlignLeft);
+    seriesMax = new QLineSeries();
+    seriesMax->setName(tr("max u"));
+    seriesMin = new QLineSeries();
+    seriesMin->setName(tr("min u"));
+    seriesMass = new QLineSeries();
+    seriesMass->setName(tr("mass / mass₀"));
+    seriesEnergy = new QLineSeries();
+    seriesEnergy->setName(tr("energy / energy₀"));
+    seriesVariation = new QLineSeries();
+    seriesVariation->setName(tr("TV / TV₀"));
+    for (auto series: {seriesMax, seriesMin, seriesMass, seriesEnergy, seriesVariation})
+    {
+        chartDiagnostics->addSeries(series);
+        series->attachAxis(axisXDiagnostics);
+        series->attachAxis(axisYDiagnostics);
+    }
+
+    diagnosticsView = new QChartView();
+    diagnosticsView->setRenderHint(QPainter::Antialiasing);
+    diagnosticsView->setChart(chartDiagnostics);
+
+    QVBoxLayout *layoutParam = new QVBoxLayout;
+    layoutParam->addWidget(chartView);
+    layoutParam->addWidget(diagnosticsView);
+    layoutParam->addLayout(layoutNxNt);
+#ifdef TRANSPORT_TRACING
+    labelTiming = new QLabel();
+    labelTiming->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    layoutParam->addWidget(labelTiming);
+    resetTiming();
+#endif
+
+    QString historyDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QDir().mkpath(historyDir);
+    historyFile_ = QDir::toNativeSeparators(QDir(historyDir).filePath("history.bin"));
+    // Off by default: the file of a large run takes up to kHistoryBytes.
+    checkBoxHistory = new QCheckBox(tr("Record"));
+    labelHistory = new QLabel();
+    labelHistory->setMinimumWidth(120);
+    sliderHistory = new QSlider(Qt::Horizontal);
+    sliderHistory->setEnabled(false);
+
+    QHBoxLayout *layoutHistory = new QHBoxLayout();
+    layoutHistory->addWidget(checkBoxHistory);
+    layoutHistory->addWidget(labelHistory);
+    layoutHistory->addWidget(sliderHistory);
+    QVBoxLayout *layoutMethods = new QVBoxLayout();
+    layoutMethods->addWidget(tabWidgetMethods);
+    layoutMethods->addLayout(layoutHistory);
+
+    QHBoxLayout *layoutMain = new QHBoxLayout();
+    layoutMain->addLayout(layoutParam);
+    layoutMain->addLayout(layoutMethods);
+
+    setLayout(layoutMain);
+
+    connect(comboBoxInitial, SIGNAL(currentIndexChanged(int)), this, SLOT(selectionChanged()));
+    connect(sliderNX, SIGNAL(valueChanged(int)), this, SLOT(update_nx_from_slider(int)));
+    connect(sliderNT, SIGNAL(valueChanged(int)), this, SLOT(update_nt(int)));
+    connect(spinBoxNX, SIGNAL(valueChanged(int)), this, SLOT(update_nx(int)));
+    connect(spinBoxNT, SIGNAL(valueChanged(int)), this, SLOT(update_nt(int)));
+    connect(tabWidgetMethods, SIGNAL(currentChanged(int)), this, SLOT(updateDispersionDiffusion()));
+    connect(pushButtonSolve, SIGNAL(clicked(bool)), this, SLOT(Solve()));
+    connect(pushButtonExport, SIGNAL(clicked(bool)), this, SLOT(SolveAndExport()));
+    connect(timer, SIGNAL(timeout()), this, SLOT(Tick()));
+    connect(previewTimer, SIGNAL(timeout()), this, SLOT(requestPreview()));
+    connect(sliderHistory, SIGNAL(valueChanged(int)), this, SLOT(showHistory(int)));
+    connect(previewThread_, SIGNAL(ready()), this, SLOT(showPreview()));
+    connect(chartInitial, SIGNAL(plotAreaChanged(QRectF)), this, SLOT(redrawViews()));
+    for (auto &tab: methodTabs_)
+    {
+        connect(tab.solution->chart(), SIGNAL(plotAreaChanged(QRectF)), this, SLOT(redrawViews()));
+        connect(tab.solution->chart()->axisX(), SIGNAL(rangeChanged(qreal,qreal)), this, SLOT(redrawViews()));
+        connect(tab.stability->chart(), SIGNAL(plotAreaChanged(QRectF)), this, SLOT(redrawStabilityMaps()));
+    }
+
+    previewThread_->start();
+    initiateState();
+    ensurePreview();
+}
+
+Form::~Form()
+{
+    stopSolver();
+    delete solver_;
+    previewThread_->requestStop();
+    previewThread_->wait();
+    delete previewThread_;
+}
+
+// Envelope over the visible x range, merged to one column per pixel of the
+// plot area, so the number of points does not depend on nx.
+static void drawEnvelope(QLineSeries *series, const Envelope &envelope, QChart *chart)
+{
+    QValueAxis *axis = qobject_cast<QValueAxis*>(chart->axisX());
+    double width = chart->plotArea().width();
+    std::size_t columns = width >= 1.0 ? static_cast<std::size_t>(width) : kViewPoints;
+    std::vector<double> x, u;
+    envelopePolyline(envelope, axis->min(), axis->max(), columns, x, u);
+
+    QVector<QPointF> data;
+    data.reserve(static_cast<int>(x.size()));
+    for (decltype(x.size()) i = 0; i < x.size(); ++i)
+        data << QPointF(x[i], u[i]);
+    series->replace(data);
+}
+
+// White where a harmonic keeps its amplitude, shading to blue where the
+// scheme damps it and to red where it grows.
+static QImage stabilityImage(const StabilityMap &map, MethodType method)
+{
+    QImage image(static_cast<int>(map.wavenumbers()), static_cast<int>(map.alphas()), QImage::Format_RGB32);
+    for (std::size_t row = 0; row < map.alphas(); ++row)
+    {
+        const double *decay = map.decay(method, row);
+        QRgb *line = reinterpret_cast<QRgb*>(image.scanLine(static_cast<int>(map.alphas() - 1 - row)));
+        for (std::size_t j = 0; j < map.wavenumbers(); ++j)
+        {
+            double t = -decay[j] / (std::abs(decay[j]) + 0.02);
+            line[j] = qRgb(static_cast<int>(255 * (1.0 + std::min(t, 0.0))),
+                           static_cast<int>(255 * (1.0 - std::abs(t))),
+                           static_cast<int>(255 * (1.0 - std::max(t, 0.0))));
+        }
+    }
+    return image;
+}
+
+static QLineSeries* createCurve(const QColor &color)
+{
+    QLineSeries *series = new QLineSeries();
+    series->setColor(color);
+    series->setPen(QPen(series->pen().brush(), 3));
+    return series;
+}
+
+// Tab of one method: dispersion and dissipation errors over the spectrum of
+// the initial profile on the left, solution snapshots on the right. Tabs are
+// added in MethodType order, so the tab index is the method.
+void Form::addMethodTab(MethodType method, const QString &title)
+{
+    MethodTab tab;
+    tab.method = method;
+    tab.idealDispersion = createCurve(Qt::blue);
+    tab.idealDissipation = createCurve(Qt::blue);
+    tab.dispersionCurve = createCurve(Qt::red);
+    tab.dissipationCurve = createCurve(Qt::red);
+    tab.spectrumDispersion = new QBarSeries();
+    tab.spectrumDissipation = new QBarSeries();
+
+    tab.idealDissipation->append(QList<QPointF>() << QPointF(0.0, 0.0) << QPointF(0.5, 0.0));
+
+    QChart *dispersionChart = new QChart();
+    dispersionChart->addSeries(tab.spectrumDispersion);
+    dispersionChart->addSeries(tab.idealDispersion);
+    dispersionChart->addSeries(tab.dispersionCurve);
+    dispersionChart->setTitle(tr("Dispersion error"));
+    dispersionChart->legend()->hide();
+
+    QValueAxis *axisXDispersion = new QValueAxis;
+    axisXDispersion->setLineVisible(false);
+    setGrid(axisXDispersion);
+    axisXDispersion->setTitleText("ϰ / ϰ_N");
+    axisXDispersion->setTitleFont(QFont("Times New Roman", 14));
+    axisXDispersion->setTickCount(3);
+    axisXDispersion->setRange(0.0, 0.5);
+    dispersionChart->addAxis(axisXDispersion, Qt::AlignBottom);
+    tab.idealDispersion->attachAxis(axisXDispersion);
+    tab.dispersionCurve->attachAxis(axisXDispersion);
+    QValueAxis *axisSpectrumXDispersion = new QValueAxis;
+    axisSpectrumXDispersion->setLineVisible(false);
+    axisSpectrumXDispersion->setLabelsVisible(false);
+    dispersionChart->addAxis(axisSpectrumXDispersion, Qt::AlignBottom);
+    tab.spectrumDispersion->attachAxis(axisSpectrumXDispersion);
+    QValueAxis *axisYDispersion = new QValueAxis;
+    axisYDispersion->setLineVisible(false);
+    setGrid(axisYDispersion);
+    axisYDispersion->setTitleText("Ω / (c⋅ϰ_N)");
+    axisYDispersion->setTitleFont(QFont("Times New Roman", 14));
+    axisYDispersion->setTickCount(3);
+    axisYDispersion->setRange(0.0, 2.0);
+    dispersionChart->addAxis(axisYDispersion, Qt::AlignLeft);
+    tab.idealDispersion->attachAxis(axisYDispersion);
+    tab.dispersionCurve->attachAxis(axisYDispersion);
+    tab.spectrumDispersion->attachAxis(axisYDispersion);
+
+    tab.dispersion = new QChartView();
+    tab.dispersion->setRenderHint(QPainter::Antialiasing);
+    tab.dispersion->setChart(dispersionChart);
+
+    QChart *dissipationChart = new QChart();
+    dissipationChart->addSeries(tab.spectrumDissipation);
+    dissipationChart->addSeries(tab.idealDissipation);
+    dissipationChart->addSeries(tab.dissipationCurve);
+    dissipationChart->setTitle(tr("Dissipation error"));
+    dissipationChart->legend()->hide();
+
+    QValueAxis *axisXDissipation = new QValueAxis;
+    axisXDissipation->setLineVisible(false);
+    setGrid(axisXDissipation);
+    axisXDissipation->setTitleText("ϰ / ϰ_N");
+    axisXDissipation->setTitleFont(QFont("Times New Roman", 14));
+    axisXDissipation->setTickCount(3);
+    axisXDissipation->setRange(0.0, 0.5);
+    dissipationChart->addAxis(axisXDissipation, Qt::AlignBottom);
+    tab.idealDissipation->attachAxis(axisXDissipation);
+    tab.dissipationCurve->attachAxis(axisXDissipation);
+    QValueAxis *axisSpectrumXDissipation = new QValueAxis;
+    axisSpectrumXDissipation->setLineVisible(false);
+    axisSpectrumXDissipation->setLabelsVisible(false);
+    dissipationChart->addAxis(axisSpectrumXDissipation, Qt::AlignBottom);
+    tab.spectrumDissipation->attachAxis(axisSpectrumXDissipation);
+    QValueAxis *axisYDissipation = new QValueAxis;
+    axisYDissipation->setLineVisible(false);
+    setGrid(axisYDissipation);
+    axisYDissipation->setTitleText("γ / (c⋅ϰ_N)");
+    axisYDissipation->setTitleFont(QFont("Times New Roman", 14));
+    axisYDissipation->setTickCount(3);
+    axisYDissipation->setRange(-3.0, 3.0);
+    dissipationChart->addAxis(axisYDissipation, Qt::AlignLeft);
+    tab.idealDissipation->attachAxis(axisYDissipation);
+    tab.dissipationCurve->attachAxis(axisYDissipation);
+    tab.spectrumDissipation->attachAxis(axisYDissipation);
+
+    tab.dissipation = new QChartView();
+    tab.dissipation->setRenderHint(QPainter::Antialiasing);
+    tab.dissipation->setChart(dissipationChart);
+
+    QChart *solutionChart = new QChart();
+    solutionChart->setTitle(tr("Solution"));
+    solutionChart->legend()->hide();
+    QValueAxis *axisXSolution = new QValueAxis;
+    axisXSolution->setLineVisible(false);
+    setGrid(axisXSolution);
+    axisXSolution->setLabelsVisible(false);
+    axisXSolution->setRange(0.0, kRangeX);
+    solutionChart->addAxis(axisXSolution, Qt::AlignBottom);
+    QValueAxis *axisYSolution = new QValueAxis;
+    axisYSolution->setLineVisible(false);
+    setGrid(axisYSolution);
+    axisYSolution->setLabelsVisible(false);
+    axisYSolution->setRange(-0.5, 1.5);
+    solutionChart->addAxis(axisYSolution, Qt::AlignLeft);
+
+    // The initial state, every milestone and the blow-up.
+    for (int i = 0; i < kMilestones + 2; ++i)
+        tab.states.push_back(new QLineSeries());
+    tab.live = new QLineSeries();
+    tab.live->setColor(Qt::gray);
+    for (auto series: tab.states)
+        solutionChart->addSeries(series);
+    solutionChart->addSeries(tab.live);
+    for (auto series: solutionChart->series())
+    {
+        series->attachAxis(axisXSolution);
+        series->attachAxis(axisYSolution);
+        series->hide();
+    }
+
+    // Drag to zoom in on a range of x, right click to zoom out.
+    tab.solution = new QChartView();
+    tab.solution->setRenderHint(QPainter::Antialiasing);
+    tab.solution->setRubberBand(QChartView::HorizontalRubberBand);
+    tab.solution->setChart(solutionChart);
+
+    tab.stabilityAlpha = createCurve(Qt::black);
+    tab.stabilityImage = stabilityImage(stabilityMap_, method);
+
+    QChart *stabilityChart = new QChart();
+    stabilityChart->addSeries(tab.stabilityAlpha);
+    stabilityChart->setTitle(tr("Amplitude error per step"));
+    stabilityChart->legend()->hide();
+    QValueAxis *axisXStability = new QValueAxis;
+    axisXStability->setLineVisible(false);
+    axisXStability->setTitleText("ϰ / ϰ_N");
+    axisXStability->setTitleFont(QFont("Times New Roman", 14));
+    axisXStability->setTickCount(3);
+    axisXStability->setRange(0.0, 0.5);
+    stabilityChart->addAxis(axisXStability, Qt::AlignBottom);
+    tab.stabilityAlpha->attachAxis(axisXStability);
+    QValueAxis *axisYStability = new QValueAxis;
+    axisYStability->setLineVisible(false);
+    axisYStability->setTitleText("α");
+    axisYStability->setTitleFont(QFont("Times New Roman", 14));
+    axisYStability->setTickCount(3);
+    axisYStability->setRange(0.0, kStabilityAlphaMax);
+    stabilityChart->addAxis(axisYStability, Qt::AlignLeft);
+    tab.stabilityAlpha->attachAxis(axisYStability);
+
+    tab.stability = new QChartView();
+    tab.stability->setRenderHint(QPainter::Antialiasing);
+    tab.stability->setChart(stabilityChart);
+
+    QVBoxLayout *left = new QVBoxLayout();
+    left->addWidget(tab.dispersion);
+    left->addWidget(tab.dissipation);
+    QVBoxLayout *right = new QVBoxLayout();
+    right->addWidget(tab.solution, 2);
+    right->addWidget(tab.stability, 1);
+    QHBoxLayout *layoutMain = new QHBoxLayout();
+    layoutMain->addLayout(left);
+    layoutMain->addLayout(right);
+    tab.widget = new QWidget();
+    tab.widget->setLayout(layoutMain);
+
+    tabWidgetMethods->addTab(tab.widget, title);
+    methodTabs_.push_back(tab);
+}
+
+void Form::update_nx_from_slider(int n)
+{
+    int new_nx = static_cast<int>(std::round(std::pow(2.0, n+3)));
+
+    spinBoxNX->blockSignals(true);
+    sliderNX->blockSignals(true);
+
+    spinBoxNX->setValue(new_nx);
+    spinBoxNX->setSingleStep(new_nx);
+
+    spinBoxNX->blockSignals(false);
+    sliderNX->blockSignals(false);
+
+    initiateState();
+}
+
+void Form::update_nx(int n)
+{
+    int old_nx = static_cast<int>(param.get_nx());
+    if (n == 0)
+    {
+        n = std::max(old_nx/2, kNxMin);
+    }
+
+    int new_nx_log = static_cast<int>(std::round(std::log2(static_cast<double>(n))));
+    int new_nx = static_cast<int>(std::round(std::pow(2.0, new_nx_log)));
+
+    spinBoxNX->blockSignals(true);
+    sliderNX->blockSignals(true);
+
+    sliderNX->setValue(new_nx_log-3);
+    spinBoxNX->setValue(new_nx);
+    spinBoxNX->setSingleStep(new_nx);
+
+    spinBoxNX->blockSignals(false);
+    sliderNX->blockSignals(false);
+
+    initiateState();
+}
+
+void Form::update_nt(int n)
+{
+    spinBoxNT->blockSignals(true);
+    sliderNT->blockSignals(true);
+
+    sliderNT->setValue(n);
+    spinBoxNT->setValue(n);
+
+    spinBoxNT->blockSignals(false);
+    sliderNT->blockSignals(false);
+
+    initiateState();
+}
+
+void Form::selectionChanged()
+{
+    initiateState();
+}
+
+void Form::updateLabels()
+{
+    labelStepX->setText(QString::number(param.get_dx(), 'f', 3));
+    labelStepT->setText(QString::number(param.get_dt(), 'f', 3));
+    labelCFL->setText(QString::number(param.get_alpha(), 'f', 3));
+}
+
+void Form::updateDispersionDiffusion()
+{
+    TRACE_SCOPE("Form::updateDispersionDiffusion");
+    method_ = static_cast<MethodType>(tabWidgetMethods->currentIndex());
+
+    double alpha = param.get_alpha();
+    double ideal_disp_max = 2.0*M_PI*alpha * 0.5;
+    std::vector<double> phase, decay;
+    for (auto &tab: methodTabs_)
+    {
+        // Slices of the stability map; CFL numbers beyond it are evaluated
+        // directly, at the same fixed number of samples for any nx.
+        QList<QPointF> disp_data, diff_data;
+        if (stabilityMap_.slice(tab.method, alpha, phase, decay))
+        {
+            for (std::size_t j = 0; j < phase.size(); ++j)
+            {
+                double xi = stabilityMap_.wavenumber(j);
+                disp_data.append(QPointF(xi, phase[j] / ideal_disp_max));
+                diff_data.append(QPointF(xi, decay[j]));
+            }
+        }
+        else
+        {
+            double xi_max = static_cast<double>(param.get_nx()/2) / (param.get_nx()-1);
+            for (int i = 0; i < kCurvePoints; ++i)
+            {
+                double xi = xi_max * i / (kCurvePoints-1);
+                std::pair<double, double> coeffs = dispersion_diffusion(xi, alpha, tab.method);
+                disp_data.append(QPointF(xi, coeffs.first / ideal_disp_max));
+                diff_data.append(QPointF(xi, coeffs.second));
+            }
+        }
+
+        tab.idealDispersion->clear();
+        tab.idealDispersion->append(QList<QPointF>() << QPointF(0.0, 0.0) << QPointF(0.5, ideal_disp_max / ideal_disp_max));
+        tab.dispersionCurve->clear();
+        tab.dispersionCurve->append(disp_data);
+        tab.dissipationCurve->clear();
+        tab.dissipationCurve->append(diff_data);
+        tab.stabilityAlpha->replace(QList<QPointF>() << QPointF(0.0, alpha) << QPointF(0.5, alpha));
+    }
+}
+
+// The maps are drawn as the plot area background, scaled to its size.
+void Form::redrawStabilityMaps()
+{
+    for (auto &tab: methodTabs_)
+    {
+        QChart *chart = tab.stability->chart();
+        QRectF area = chart->plotArea();
+        if (area.width() < 1.0 || area.height() < 1.0)
+            continue;
+        QBrush brush(tab.stabilityImage.scaled(area.size().toSize(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+        brush.setTransform(QTransform::fromTranslate(area.left(), area.top()));
+        chart->setPlotAreaBackgroundBrush(brush);
+        chart->setPlotAreaBackgroundVisible(true);
+    }
+}
+
+void Form::initiateState()
+{
+    TRACE_SCOPE("Form::initiateState");
+    param = Parameters(spinBoxNX->value()+1, spinBoxNT->value(), kRangeX, kRangeT);
+    method_ = static_cast<MethodType>(tabWidgetMethods->currentIndex());
+
+    if (previewCurrent())
+        previewTimer->stop();
+    else
+        previewTimer->start();
+
+    updateLabels();
+    updateDispersionDiffusion();
+    cleanSolution();
+}
+
+InitialProfile Form::selectedProfile() const
+{
+    return static_cast<InitialProfile>(comboBoxInitial->currentData().toInt());
+}
+
+bool Form::previewCurrent() const
+{
+    return preview_.nx == param.get_nx() && preview_.profile == selectedProfile();
+}
+
+void Form::requestPreview()
+{
+    previewThread_->request(param.get_nx(), selectedProfile());
+}
+
+// Previews for settings changed in the meantime are dropped.
+void Form::showPreview()
+{
+    Preview preview;
+    if (!previewThread_->take(preview) || preview.nx != param.get_nx() || preview.profile != selectedProfile())
+        return;
+    std::swap(preview_, preview);
+    drawPreview();
+}
+
+// Solving cannot wait for the background thread.
+void Form::ensurePreview()
+{
+    if (previewCurrent())
+        return;
+    previewTimer->stop();
+    computePreview(param.get_nx(), selectedProfile(), [] { return false; }, preview_);
+    drawPreview();
+}
+
+void Form::drawPreview()
+{
+    TRACE_SCOPE("Form::drawPreview");
+    drawEnvelope(seriesInitial, preview_.initial, chartView->chart());
+
+    QList<double> spectrum_data;
+    for (auto value: preview_.spectrum)
+        spectrum_data.append(value);
+
+    for (auto &tab: methodTabs_)
+    {
+        for (auto& barseries: {tab.spectrumDispersion, tab.spectrumDissipation})
+        {
+            QBarSet *barSpectrum = new QBarSet("");
+            barSpectrum->append(spectrum_data);
+            barSpectrum->setColor(Qt::darkGreen);
+            barseries->clear();
+            barseries->append(barSpectrum);
+            barseries->attachedAxes()[0]->setRange(0, barSpectrum->count());
+            barseries->setBarWidth(barSpectrum->count()*(barSpectrum->count() < 50 ? 0.03 : 0.01));
+        }
+    }
+}
+
+void Form::cleanSolution()
+{
+    for (auto &tab: methodTabs_)
+    {
+        for (auto series: tab.states)
+        {
+            series->clear();
+            series->hide();
+        }
+        tab.live->clear();
+        tab.live->hide();
+        tab.shown.clear();
+        tab.liveShown = Envelope();
+        tab.solution->chart()->zoomReset();
+    }
+    for (auto series: {seriesMax, seriesMin, seriesMass, seriesEnergy, seriesVariation})
+        series->clear();
+
+    historyReader_.close();
+    sliderHistory->setEnabled(false);
+    sliderHistory->setRange(0, 0);
+    labelHistory->clear();
+}
+
+void Form::Solve()
+{
+    pushButtonSolve->setEnabled(false);
+    pushButtonExport->setEnabled(false);
+    tabWidgetMethods->setEnabled(false);
+    comboBoxInitial->setEnabled(false);
+    checkBoxFourier->setEnabled(false);
+    checkBoxHistory->setEnabled(false);
+    spinBoxNX->setEnabled(false);
+    spinBoxNT->setEnabled(false);
+    sliderNX->setEnabled(false);
+    sliderNT->setEnabled(false);
+
+    initiateState();
+    ensurePreview();
+    delete solver_;
+    solver_ = new Solver(param, selectedProfile(), method_);
+    solver_->setThreads(0);
+    solver_->setFourierPropagation(checkBoxFourier->isChecked() || method_ == Spectral);
+
+    Snapshot initial;
+    initial.view = preview_.initial;
+    initial.diagnostics = solver_->diagnostics().reduced(kCurvePoints);
+    showState(initial);
+
+    milestonesShown_ = 0;
+#ifdef TRANSPORT_TRACING
+    resetTiming();
+#endif
+    // The budget keeps the file within kHistoryBytes; a run without it
+    // goes on regardless. Without recording, the last run's file goes, so
+    // that it is neither shown for this one nor left taking up space.
+    if (checkBoxHistory->isChecked())
+        history_.open(historyFile_.toStdString(), param, historyStride(param.get_nx(), param.get_nt()));
+    else
+        QFile::remove(historyFile_);
+    // Snapshots the writer thread cannot keep up with are dropped rather
+    // than slowing the run down.
+    if (!exportFile_.isEmpty())
+    {
+        ExportFormat format = exportFile_.endsWith(".csv", Qt::CaseInsensitive) ? ExportCsv : ExportBinary;
+        if (!exporter_.open(exportFile_.toStdString(), format, *solver_, exportStride(param.get_nt())))
+            QMessageBox::warning(this, tr("Export"), tr("Cannot open %1").arg(exportFile_));
+        exportFile_.clear();
+    }
+    solverThread_ = new SolverThread(solver_, history_.isOpen() ? &history_ : nullptr,
+                                     exporter_.isOpen() ? &exporter_ : nullptr);
+    solverThread_->start();
+    timer->start();
+}
+
+void Form::Tick()
+{
+    TRACE_SCOPE("Form::Tick");
+    bool done = solverThread_->isFinished();
+
+    for (int count = solverThread_->milestoneCount(); milestonesShown_ < count; ++milestonesShown_)
+        showState(solverThread_->milestone(milestonesShown_));
+
+    if (done)
+    {
+        stopSolver();
+        finishCalculation();
+    }
+    else if (solverThread_->takeLatest())
+    {
+        showLive(solverThread_->latest());
+#ifdef TRANSPORT_TRACING
+        timingSteps_ = solverThread_->latest().steps;
+#endif
+    }
+
+#ifdef TRANSPORT_TRACING
+    updateTiming();
+#endif
+}
+
+void Form::stopSolver()
+{
+    if (!solverThread_)
+        return;
+
+    solverThread_->requestStop();
+    solverThread_->wait();
+    delete solverThread_;
+    solverThread_ = nullptr;
+    history_.close();
+}
+
+void Form::finishCalculation()
+{
+    timer->stop();
+    pushButtonSolve->setEnabled(true);
+    pushButtonExport->setEnabled(true);
+    tabWidgetMethods->setEnabled(true);
+    comboBoxInitial->setEnabled(true);
+    checkBoxFourier->setEnabled(true);
+    checkBoxHistory->setEnabled(true);
+    spinBoxNX->setEnabled(true);
+    spinBoxNT->setEnabled(true);
+    sliderNX->setEnabled(true);
+    sliderNT->setEnabled(true);
+    openHistory();
+
+    if (exporter_.isOpen())
+    {
+        if (!exporter_.finish(solver_->diagnostics()))
+            QMessageBox::warning(this, tr("Export"), tr("The export could not be written completely"));
+        else if (exporter_.dropped() > 0)
+            QMessageBox::information(this, tr("Export"), tr("%1 snapshots were skipped to keep up with the solver")
+                                     .arg(exporter_.dropped()));
+    }
+}
+
+void Form::SolveAndExport()
+{
+    exportFile_ = QFileDialog::getSaveFileName(this, tr("Export"), QString(),
+                                               tr("Columnar binary (*.bin);;CSV (*.csv)"));
+    if (!exportFile_.isEmpty())
+        Solve();
+}
+
+void Form::openHistory()
+{
+    if (!historyReader_.open(historyFile_.toStdString()) || historyReader_.frames() == 0)
+        return;
+
+    int last = static_cast<int>(std::min<std::int64_t>(historyReader_.frames() - 1, INT_MAX));
+    sliderHistory->blockSignals(true);
+    sliderHistory->setRange(0, last);
+    sliderHistory->setValue(last);
+    sliderHistory->blockSignals(false);
+    sliderHistory->setEnabled(true);
+    showHistory(last);
+}
+
+// A recorded step in place of the live curve; the grid is read straight
+// from the mapping, and only the envelope is kept.
+void Form::showHistory(int index)
+{
+    TRACE_SCOPE("Form::showHistory");
+    HistoryFrame frame;
+    if (!solver_ || !historyReader_.frame(index, frame))
+        return;
+
+    MethodTab &tab = methodTabs_[solver_->method()];
+    reduceEnvelope(frame.values, static_cast<std::size_t>(historyReader_.nx()), historyReader_.dx(), kViewPoints,
+                   tab.liveShown);
+    drawEnvelope(tab.live, tab.liveShown, tab.solution->chart());
+    tab.live->show();
+    labelHistory->setText(QString("t = %1").arg(frame.time, 0, 'f', 3));
+}
+
+void Form::showState(const Snapshot &snapshot)
+{
+    TRACE_SCOPE("Form::showState");
+    MethodTab &tab = methodTabs_[method_];
+    if (tab.shown.size() >= tab.states.size())
+        return;
+
+    tab.live->hide();
+    tab.liveShown = Envelope();
+    for (std::size_t i = 0; i < tab.shown.size(); ++i)
+        tab.states[i]->setOpacity(0.5);
+
+    QLineSeries *series = tab.states[tab.shown.size()];
+    tab.shown.push_back(snapshot.view);
+    drawEnvelope(series, tab.shown.back(), tab.solution->chart());
+    series->setOpacity(1.0);
+    series->show();
+
+    showDiagnostics(snapshot.diagnostics);
+}
+
+void Form::showLive(const Snapshot &snapshot)
+{
+    TRACE_SCOPE("Form::showLive");
+    MethodTab &tab = methodTabs_[method_];
+    tab.liveShown = snapshot.view;
+    drawEnvelope(tab.live, tab.liveShown, tab.solution->chart());
+    tab.live->show();
+
+    showDiagnostics(snapshot.diagnostics);
+}
+
+// Re-decimates the cached envelopes after a zoom or a resize.
+void Form::redrawViews()
+{
+    TRACE_SCOPE("Form::redrawViews");
+    if (!preview_.initial.lo.empty())
+        drawEnvelope(seriesInitial, preview_.initial, chartView->chart());
+    for (auto &tab: methodTabs_)
+    {
+        QChart *chart = tab.solution->chart();
+        for (std::size_t i = 0; i < tab.shown.size(); ++i)
+            drawEnvelope(tab.states[i], tab.shown[i], chart);
+        if (!tab.liveShown.lo.empty())
+            drawEnvelope(tab.live, tab.liveShown, chart);
+    }
+}
+
+// Extremes as they are; mass, energy and variation relative to the start.
+void Form::showDiagnostics(const std::vector<Diagnostics> &samples)
+{
+    if (samples.empty())
+        return;
+
+    auto scale = [](double initial) { return initial != 0.0 ? 1.0 / initial : 1.0; };
+    double mass = scale(samples.front().mass);
+    double energy = scale(samples.front().energy);
+    double variation = scale(samples.front().variation);
+
+    QVector<QPointF> max_data, min_data, mass_data, energy_data, variation_data;
+    for (const auto &d: samples)
+    {
+        max_data << QPointF(d.time, d.max);
+        min_data << QPointF(d.time, d.min);
+        mass_data << QPointF(d.time, d.mass * mass);
+        energy_data << QPointF(d.time, d.energy * energy);
+        variation_data << QPointF(d.time, d.variation * variation);
+    }
+    seriesMax->replace(max_data);
+    seriesMin->replace(min_data);
+    seriesMass->replace(mass_data);
+    seriesEnergy->replace(energy_data);
+    seriesVariation->replace(variation_data);
+}
+
+#ifdef TRANSPORT_TRACING
+void Form::resetTiming()
+{
+    timingClock_.start();
+    timingTotals_ = traceTotals();
+    timingFrames_ = 0;
+    timingSteps_ = timingLastSteps_ = 0;
+}
+
+void Form::updateTiming()
+{
+    ++timingFrames_;
+    if (timingClock_.elapsed() < 500)
+        return;
+
+    double seconds = timingClock_.restart() * 1e-3;
+    std::vector<TracePhase> totals = traceTotals();
+    QStringList lines;
+    lines << QString("%1 steps/s").arg((timingSteps_ - timingLastSteps_) / seconds, 0, 'g', 4);
+    for (const auto &phase: totals)
+    {
+        double before = 0.0;
+        for (const auto &old: timingTotals_)
+            if (std::strcmp(old.name, phase.name) == 0)
+                before = old.seconds;
+        lines << QString("%1: %2 ms/frame").arg(phase.name).arg((phase.seconds - before) * 1e3 / timingFrames_, 0, 'f', 2);
+    }
+    labelTiming->setText(lines.join("\n"));
+
+    timingTotals_ = totals;
+    timingFrames_ = 0;
+    timingLastSteps_ = timingSteps_;
+}
+#endif
@@ -0,0 +1,151 @@
+#ifndef FORM_H
+#define FORM_H
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QPushButton>
+#include <QSlider>
+#include <QSpinBox>
+#include <QTabWidget>
+#include <QTimer>
+#include <QWidget>
+
+#include <vector>
+
+#include <QtCharts/QtCharts>
+QT_CHARTS_USE_NAMESPACE
+
+#include "history.h"
+#include "parameters.h"
+#include "previewthread.h"
+#include "solver.h"
+#include "solverthread.h"
+#include "stability.h"
+#include "trace.h"
+#include "view.h"
+
+constexpr int kNxMin = 16;
+constexpr int kNxMax = 1 << 20;
+constexpr int kNtMin = 10;
+constexpr int kNtMax = 1000000;
+// Milliseconds the settings must stay put before the preview is recomputed.
+constexpr int kPreviewDelay = 30;
+
+class Form : public QWidget
+{
+    Q_OBJECT
+
+public:
+    Form(QWidget *parent = 0);
+    ~Form();
+
+private slots:
+    void update_nx_from_slider(int log_n);
+    void update_nx(int n);
+    void update_nt(int n);
+    void selectionChanged();
+    void updateLabels();
+    void initiateState();
+    void requestPreview();
+    void showPreview();
+    void updateDispersionDiffusion();
+    void Solve();
+    void SolveAndExport();
+    void Tick();
+    void redrawViews();
+    void redrawStabilityMaps();
+    void showHistory(int index);
+
+private:
+    QChartView *chartView;
+    QLabel *labelInitial;
+    QComboBox *comboBoxInitial;
+    QLabel *labelSizeX_1, *labelSizeX_2, *labelSizeT_1, *labelSizeT_2, *labelNX_1, *labelNX_2, *labelNT_1, *labelNT_2;
+    QLabel *labelSizeX, *labelSizeT;
+    QSlider *sliderNX, *sliderNT;
+    QSpinBox *spinBoxNX, *spinBoxNT;
+    QLabel *labelStepX_1, *labelStepX_2, *labelStepX;
+    QLabel *labelStepT_1, *labelStepT_2, *labelStepT;
+    QLabel *labelCFL_1, *labelCFL_2, *labelCFL;
+    QCheckBox *checkBoxFourier;
+    QPushButton *pushButtonSolve;
+    QPushButton *pushButtonExport;
+    QTabWidget *tabWidgetMethods;
+    QCheckBox *checkBoxHistory;
+    QLabel *labelHistory;
+    QSlider *sliderHistory;
+    QLineSeries *seriesInitial;
+    QChartView *diagnosticsView;
+    QLineSeries *seriesMax, *seriesMin, *seriesMass, *seriesEnergy, *seriesVariation;
+
+    struct MethodTab
+    {
+        MethodType method;
+        QWidget *widget;
+        QChartView *dispersion, *dissipation, *solution;
+        QLineSeries *idealDispersion, *idealDissipation;
+        QLineSeries *dispersionCurve, *dissipationCurve;
+        QBarSeries *spectrumDispersion, *spectrumDissipation;
+        // Amplitude error over the whole (wavenumber, CFL) plane, with the
+        // current CFL number marked.
+        QChartView *stability;
+        QLineSeries *stabilityAlpha;
+        QImage stabilityImage;
+        // Series for the snapshots and the live state, created once and
+        // refilled; the envelopes they show are kept to redraw on zoom.
+        std::vector<QLineSeries*> states;
+        QLineSeries *live;
+        std::vector<Envelope> shown;
+        Envelope liveShown;
+    };
+    std::vector<MethodTab> methodTabs_;
+
+    QTimer *timer;
+    QTimer *previewTimer;
+
+    StabilityMap stabilityMap_;
+
+    Parameters param;
+    MethodType method_;
+    Solver *solver_;
+    PreviewThread *previewThread_;
+    Preview preview_;
+    // Every recorded step of the last run, paged in from disk by the
+    // timeline slider.
+    QString historyFile_;
+    HistoryWriter history_;
+    HistoryReader historyReader_;
+    // Set by SolveAndExport for the run it starts.
+    QString exportFile_;
+    Exporter exporter_;
+    SolverThread *solverThread_;
+    int milestonesShown_;
+
+#ifdef TRANSPORT_TRACING
+    // Live summary of the trace: solver steps/s and ms per frame by phase.
+    QLabel *labelTiming;
+    QElapsedTimer timingClock_;
+    std::vector<TracePhase> timingTotals_;
+    int timingFrames_;
+    std::int64_t timingSteps_, timingLastSteps_;
+
+    void resetTiming();
+    void updateTiming();
+#endif
+
+    void addMethodTab(MethodType method, const QString &title);
+    InitialProfile selectedProfile() const;
+    bool previewCurrent() const;
+    void ensurePreview();
+    void drawPreview();
+    void showState(const Snapshot &snapshot);
+    void showLive(const Snapshot &snapshot);
+    void showDiagnostics(const std::vector<Diagnostics> &samples);
+    void stopSolver();
+    void finishCalculation();
+    void openHistory();
+    void cleanSolution();
+};
+
+#endif // FORM_H
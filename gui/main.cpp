@@ -0,0 +1,40 @@
+#include "form.h"
+#include <QApplication>
+#include <QDir>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTranslator>
+
+#include "spectrum.h"
+#include "trace.h"
+
+
+int main(int argc, char *argv[])
+{   
+    QApplication a(argc, argv);
+
+    QTranslator translator;
+    translator.load("TransferEquation1D_rus", a.applicationDirPath());
+    a.installTranslator(&translator);
+
+    QFont defaultFont;
+    defaultFont.setPixelSize(14);
+    a.setFont(defaultFont);
+
+    // Plans are measured once and remembered between sessions.
+    QString wisdomDir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(wisdomDir);
+    QString wisdomFile = QDir(wisdomDir).filePath("fftw.wisdom");
+    loadFftWisdom(QDir::toNativeSeparators(wisdomFile).toStdString());
+    setFftEffort(FftMeasure);
+    setFftThreads(QThread::idealThreadCount());
+
+    Form w;
+    w.show();
+
+    int result = a.exec();
+    saveFftWisdom(QDir::toNativeSeparators(wisdomFile).toStdString());
+    if (kTracing)
+        writeChromeTrace(QDir::toNativeSeparators(QDir(wisdomDir).filePath("trace.json")).toStdString());
+    return result;
+}
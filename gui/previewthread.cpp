@@ -0,0 +1,107 @@
+#include "previewthread.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "parameters.h"
+#include "spectrum.h"
+#include "trace.h"
+
+bool computePreview(std::int64_t nx, InitialProfile profile, const std::function<bool()> &cancelled, Preview &preview)
+{
+    TRACE_SCOPE("computePreview");
+    const Parameters param(nx, 1, kRangeX, kRangeT);
+    std::vector<double> initial = initialState(param, profile);
+    if (cancelled())
+        return false;
+
+    preview.nx = nx;
+    preview.profile = profile;
+    reduceEnvelope(initial.data(), initial.size(), param.get_dx(), kViewPoints, preview.initial);
+    if (cancelled())
+        return false;
+
+    std::vector<double> spectrum = amplitudeSpectrum(initial);
+    if (cancelled())
+        return false;
+    auto max_norm = *std::max_element(++spectrum.begin(), spectrum.end());  // ++ due to 0-harmonic is too high
+
+    // Large grids are shown as at most kSpectrumBars bars, each the maximum of its bin.
+    auto bin = (spectrum.size() + kSpectrumBars - 1) / kSpectrumBars;
+    preview.spectrum.clear();
+    for (decltype(spectrum.size()) i = 0; i < spectrum.size(); i += bin)
+    {
+        auto last = std::min(i + bin, spectrum.size());
+        preview.spectrum.push_back(*std::max_element(spectrum.begin() + i, spectrum.begin() + last) / max_norm * 1.5);
+    }
+    return true;
+}
+
+PreviewThread::PreviewThread(QObject *parent)
+    : QThread(parent), generation_(0), stop_(false), pending_(false), done_(false), nx_(0), profile_(Gauss)
+{
+}
+
+void PreviewThread::request(std::int64_t nx, InitialProfile profile)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    nx_ = nx;
+    profile_ = profile;
+    pending_ = true;
+    done_ = false;
+    generation_.fetch_add(1, std::memory_order_relaxed);
+    wake_.notify_one();
+}
+
+void PreviewThread::requestStop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_.store(true, std::memory_order_relaxed);
+    wake_.notify_one();
+}
+
+bool PreviewThread::take(Preview &preview)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!done_)
+        return false;
+    std::swap(preview, result_);
+    done_ = false;
+    return true;
+}
+
+void PreviewThread::run()
+{
+    Preview preview;
+    for (;;)
+    {
+        std::int64_t nx;
+        InitialProfile profile;
+        unsigned generation;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return pending_ || stop_.load(std::memory_order_relaxed); });
+            if (stop_.load(std::memory_order_relaxed))
+                return;
+            nx = nx_;
+            profile = profile_;
+            generation = generation_.load(std::memory_order_relaxed);
+            pending_ = false;
+        }
+
+        auto cancelled = [this, generation] {
+            return stop_.load(std::memory_order_relaxed) || generation_.load(std::memory_order_relaxed) != generation;
+        };
+        if (!computePreview(nx, profile, cancelled, preview))
+            continue;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (generation_.load(std::memory_order_relaxed) != generation)
+                continue;
+            std::swap(result_, preview);
+            done_ = true;
+        }
+        emit ready();
+    }
+}
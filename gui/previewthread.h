@@ -0,0 +1,63 @@
+#ifndef PREVIEWTHREAD_H
+#define PREVIEWTHREAD_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <QThread>
+
+#include "profile.h"
+#include "view.h"
+
+// What the form shows of the initial state before a run. Depends only on
+// nx and the profile.
+struct Preview
+{
+    std::int64_t nx = 0;
+    InitialProfile profile = Gauss;
+    Envelope initial;
+    // At most kSpectrumBars bin maxima, the largest non-zero harmonic at 1.5.
+    std::vector<double> spectrum;
+};
+
+// Computes a preview, giving up (and returning false) as soon as cancelled
+// says so; it is asked between the passes over the grid.
+bool computePreview(std::int64_t nx, InitialProfile profile, const std::function<bool()> &cancelled, Preview &preview);
+
+// Recomputes the preview for the latest settings in the background. A
+// request only records the settings, so a burst of them is coalesced into
+// one computation, and work for superseded settings is abandoned. ready()
+// is emitted when the preview of the latest request can be taken.
+class PreviewThread : public QThread
+{
+    Q_OBJECT
+
+public:
+    PreviewThread(QObject *parent = 0);
+
+    void request(std::int64_t nx, InitialProfile profile);
+    void requestStop();
+    bool take(Preview &preview);
+
+signals:
+    void ready();
+
+protected:
+    void run() override;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<unsigned> generation_;
+    std::atomic<bool> stop_;
+    bool pending_, done_;
+    std::int64_t nx_;
+    InitialProfile profile_;
+    Preview result_;
+};
+
+#endif // PREVIEWTHREAD_H
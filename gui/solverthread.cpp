@@ -0,0 +1,94 @@
+#include "solverthread.h"
+
+#include <algorithm>
+
+#include "trace.h"
+#include "view.h"
+
+SolverThread::SolverThread(Solver *solver, HistoryWriter *history, Exporter *exporter, QObject *parent)
+    : QThread(parent), solver_(solver), history_(history), exporter_(exporter), stop_(false), milestone_count_(0)
+{
+}
+
+void SolverThread::requestStop()
+{
+    stop_.store(true, std::memory_order_relaxed);
+}
+
+bool SolverThread::takeLatest()
+{
+    return latest_.update();
+}
+
+const Snapshot& SolverThread::latest() const
+{
+    return latest_.front();
+}
+
+int SolverThread::milestoneCount() const
+{
+    return milestone_count_.load(std::memory_order_acquire);
+}
+
+const Snapshot& SolverThread::milestone(int index) const
+{
+    return milestones_[index];
+}
+
+void SolverThread::run()
+{
+    std::int64_t nt = solver_->parameters().get_nt();
+    int count = 0;
+    if (history_)
+        history_->append(*solver_, true);
+    if (exporter_)
+        exporter_->append(*solver_, true);
+
+    while (!solver_->finished() && !stop_.load(std::memory_order_relaxed))
+    {
+        // Advance in time tiles, but never past the next milestone or
+        // recorded step.
+        std::int64_t next = (nt * (count+1) + kMilestones - 1) / kMilestones;
+        if (history_)
+            next = std::min(next, history_->nextStep(solver_->steps()));
+        if (exporter_)
+            next = std::min(next, exporter_->nextStep(solver_->steps()));
+        solver_->advance(std::min<std::int64_t>(next - solver_->steps(), kTileSteps));
+        bool diverged = solver_->diverged();
+
+        // A full disk ends the history, not the run.
+        if (history_ && !history_->append(*solver_, diverged || solver_->finished()))
+        {
+            history_->close();
+            history_ = nullptr;
+        }
+        if (exporter_)
+            exporter_->append(*solver_, diverged || solver_->finished());
+
+        if (diverged || solver_->steps() * kMilestones >= nt * (count+1))
+        {
+            store(milestones_[count]);
+            milestone_count_.store(++count, std::memory_order_release);
+        }
+
+        if (latest_.consumed() || diverged || solver_->finished())
+        {
+            store(latest_.back());
+            latest_.publish();
+        }
+
+        if (diverged)
+            break;
+    }
+}
+
+void SolverThread::store(Snapshot &snapshot) const
+{
+    TRACE_SCOPE("SolverThread::store");
+    const Field &state = solver_->state();
+    reduceEnvelope(state.data(), state.size(), solver_->parameters().get_dx(), kViewPoints, snapshot.view);
+    snapshot.steps = solver_->steps();
+    snapshot.time = solver_->time();
+    snapshot.diverged = solver_->diverged();
+    snapshot.diagnostics = solver_->diagnostics().reduced(kCurvePoints);
+}
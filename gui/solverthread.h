@@ -0,0 +1,52 @@
+#ifndef SOLVERTHREAD_H
+#define SOLVERTHREAD_H
+
+#include <atomic>
+
+#include <QThread>
+
+#include "exporter.h"
+#include "history.h"
+#include "snapshot.h"
+#include "solver.h"
+#include "triplebuffer.h"
+
+constexpr int kMilestones = 5;
+
+// Runs the time loop of a Solver as fast as possible. The latest state is
+// handed to the GUI through a triple buffer whenever the previous one has
+// been picked up; the states at every 1/kMilestones of the run (and at the
+// blow-up, if any) are kept in fixed slots so none of them is lost. With a
+// history writer every stride-th step of the full grid is streamed to it,
+// and likewise to an exporter.
+class SolverThread : public QThread
+{
+    Q_OBJECT
+
+public:
+    SolverThread(Solver *solver, HistoryWriter *history = nullptr, Exporter *exporter = nullptr, QObject *parent = 0);
+
+    void requestStop();
+
+    bool takeLatest();
+    const Snapshot& latest() const;
+
+    int milestoneCount() const;
+    const Snapshot& milestone(int index) const;
+
+protected:
+    void run() override;
+
+private:
+    Solver *solver_;
+    HistoryWriter *history_;
+    Exporter *exporter_;
+    std::atomic<bool> stop_;
+    TripleBuffer<Snapshot> latest_;
+    Snapshot milestones_[kMilestones + 1];
+    std::atomic<int> milestone_count_;
+
+    void store(Snapshot &snapshot) const;
+};
+
+#endif // SOLVERTHREAD_H
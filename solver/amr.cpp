@@ -0,0 +1,452 @@
+#include "amr.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "kernels.h"
+#include "trace.h"
+
+namespace {
+
+double minmod(double a, double b)
+{
+    if (a * b <= 0.0)
+        return 0.0;
+    return std::abs(a) < std::abs(b) ? a : b;
+}
+
+}
+
+bool isAmrMethod(MethodType type)
+{
+    switch (type)
+    {
+    case Upwind:
+    case LaxWendroff:
+    case MusclMinmod:
+    case MusclSuperbee:
+    case MusclVanLeer:
+        return true;
+    default:
+        return false;
+    }
+}
+
+AmrSolver::AmrSolver(const Parameters &param, InitialProfile profile, MethodType method,
+                     const AmrSettings &settings)
+    : param_(param), profile_(profile), method_(method), settings_(settings),
+      alpha_(param.get_alpha()), inflow_(initial(0.0, profile)), steps_(0),
+      levels_(1 + std::max(settings.levels, 0))
+{
+    settings_.min_block = std::max<std::int64_t>(settings_.min_block, 1);
+    settings_.regrid_interval = std::max(settings_.regrid_interval, 1);
+
+    const double dx = param_.get_dx();
+    std::int64_t cells = param_.get_nx() - 1;
+    for (Level &level: levels_)
+    {
+        level.cells = cells;
+        cells *= kAmrRatio;
+    }
+
+    Block base;
+    base.begin = 0;
+    base.end = levels_[0].cells;
+    base.u.resize(base.end + 2*kAmrGhost);
+    for (std::int64_t k = 0; k < base.end; ++k)
+        base.u[kAmrGhost + k] = initial((k + 0.5) * dx, profile_);
+    base.left = base.right = 0.0;
+    levels_[0].blocks.push_back(std::move(base));
+
+    regrid(true);
+    record();
+}
+
+void AmrSolver::step()
+{
+    TRACE_SCOPE("AmrSolver::step");
+    if (steps_ > 0 && steps_ % settings_.regrid_interval == 0)
+        regrid(false);
+    advance(0, 0.0);
+    ++steps_;
+    record();
+}
+
+void AmrSolver::run()
+{
+    while (!finished() && !diverged())
+        step();
+}
+
+bool AmrSolver::finished() const
+{
+    return steps_ >= param_.get_nt();
+}
+
+bool AmrSolver::diverged() const
+{
+    return blownUp(diagnostics_.latest());
+}
+
+const Parameters& AmrSolver::parameters() const
+{
+    return param_;
+}
+
+InitialProfile AmrSolver::profile() const
+{
+    return profile_;
+}
+
+MethodType AmrSolver::method() const
+{
+    return method_;
+}
+
+std::int64_t AmrSolver::steps() const
+{
+    return steps_;
+}
+
+double AmrSolver::time() const
+{
+    return steps_ * param_.get_dt();
+}
+
+int AmrSolver::levels() const
+{
+    int count = 0;
+    while (count < static_cast<int>(levels_.size()) && !levels_[count].blocks.empty())
+        ++count;
+    return count;
+}
+
+std::int64_t AmrSolver::cells(int level) const
+{
+    std::int64_t count = 0;
+    for (const Block &block: levels_[level].blocks)
+        count += block.end - block.begin;
+    return count;
+}
+
+std::int64_t AmrSolver::cells() const
+{
+    std::int64_t count = 0;
+    for (int level = 0; level < levels(); ++level)
+        count += cells(level);
+    return count;
+}
+
+void AmrSolver::composite(std::vector<double> &x, std::vector<double> &u, std::vector<double> &width) const
+{
+    x.clear();
+    u.clear();
+    width.clear();
+    const Block &base = levels_[0].blocks.front();
+    emit(0, base, base.begin, base.end, x, u, width);
+}
+
+const DiagnosticsSeries& AmrSolver::diagnostics() const
+{
+    return diagnostics_;
+}
+
+// The level takes its step; when the next one holds blocks, these take two
+// steps over the same time, at the start and middle of it, and then correct
+// the level where they overlap or touch it.
+void AmrSolver::advance(int level, double theta)
+{
+    const bool refined = level + 1 < static_cast<int>(levels_.size()) && !levels_[level+1].blocks.empty();
+    for (Block &block: levels_[level].blocks)
+    {
+        if (refined)
+            block.old = block.u;
+        fillGhosts(level, block, theta);
+        stepBlock(block);
+    }
+    if (!refined)
+        return;
+
+    for (Block &block: levels_[level+1].blocks)
+        block.left = block.right = 0.0;
+    for (int substep = 0; substep < kAmrRatio; ++substep)
+        advance(level + 1, static_cast<double>(substep) / kAmrRatio);
+    reflux(level);
+    averageDown(level);
+}
+
+// u[i] -= alpha (F[i+1] - F[i]) with the upwind face value traced over the
+// step, F = u[i-1] + (1 - alpha) (face[i-1] - u[i-1]): first order for
+// Upwind, the downwind slope for LaxWendroff, the limited one for MUSCL.
+void AmrSolver::stepBlock(Block &block)
+{
+    const std::int64_t n = block.end - block.begin;
+    double *u = block.u.data() + kAmrGhost;
+    block.flux.resize(n + 1);
+    double *flux = block.flux.data();
+
+    if (method_ == Upwind)
+    {
+        for (std::int64_t f = 0; f <= n; ++f)
+            flux[f] = u[f-1];
+    }
+    else if (method_ == LaxWendroff)
+    {
+        const double c = 0.5 * (1.0 - alpha_);
+        for (std::int64_t f = 0; f <= n; ++f)
+            flux[f] = u[f-1] + c * (u[f] - u[f-1]);
+    }
+    else
+    {
+        faces_.resize(n + 1);
+        reconstructFaces(u - 1, faces_.data(), n + 1, method_);
+        const double c = 1.0 - alpha_;
+        for (std::int64_t f = 0; f <= n; ++f)
+            flux[f] = u[f-1] + c * (faces_[f] - u[f-1]);
+    }
+
+    for (std::int64_t i = 0; i < n; ++i)
+        u[i] -= alpha_ * (flux[i+1] - flux[i]);
+    block.left += flux[0];
+    block.right += flux[n];
+}
+
+void AmrSolver::fillGhosts(int level, Block &block, double theta) const
+{
+    const std::int64_t n = block.end - block.begin;
+    double *u = block.u.data() + kAmrGhost;
+    for (std::int64_t g = 1; g <= kAmrGhost; ++g)
+    {
+        u[-g] = block.begin == 0 ? inflow_ : prolong(level, block.begin - g, theta);
+        u[n-1+g] = block.end == levels_[level].cells ? u[n-1] : prolong(level, block.end - 1 + g, theta);
+    }
+}
+
+double AmrSolver::value(int level, std::int64_t cell, double theta) const
+{
+    // Beyond the domain, the boundary conditions.
+    if (cell < 0)
+        return inflow_;
+    if (cell >= levels_[level].cells)
+        return value(level, levels_[level].cells - 1, theta);
+    const Block *block = findBlock(level, cell);
+    const std::size_t k = kAmrGhost + cell - block->begin;
+    if (theta == 0.0 && !block->old.empty())
+        return block->old[k];
+    if (theta == 1.0 || block->old.empty())
+        return block->u[k];
+    return (1.0 - theta) * block->old[k] + theta * block->u[k];
+}
+
+// The coarse cell split in two along its minmod slope, so that the fine
+// cells average to it and no new extremum appears.
+double AmrSolver::prolong(int level, std::int64_t cell, double theta) const
+{
+    const std::int64_t coarse = cell / kAmrRatio;
+    const double centre = value(level - 1, coarse, theta);
+    const double slope = minmod(centre - value(level - 1, coarse - 1, theta),
+                                value(level - 1, coarse + 1, theta) - centre);
+    return centre + (cell % kAmrRatio == 0 ? -0.25 : 0.25) * slope;
+}
+
+// The coarse cell beside a coarse-fine face was updated with the coarse
+// flux through it, while the fine side saw the fine fluxes of the substeps;
+// exchanging one for the other keeps the mass that crossed the face the
+// same on both sides. Faces on the domain boundary have no coarse cell
+// outside.
+void AmrSolver::reflux(int level)
+{
+    const Level &fine = levels_[level+1];
+    for (const Block &child: fine.blocks)
+    {
+        if (child.begin > 0)
+        {
+            const std::int64_t face = child.begin / kAmrRatio;
+            Block &parent = *findBlock(level, face - 1);
+            const double coarse = parent.flux[face - parent.begin];
+            parent.u[kAmrGhost + face - 1 - parent.begin] += alpha_ * (coarse - child.left / kAmrRatio);
+        }
+        if (child.end < fine.cells)
+        {
+            const std::int64_t face = child.end / kAmrRatio;
+            Block &parent = *findBlock(level, face);
+            const double coarse = parent.flux[face - parent.begin];
+            parent.u[kAmrGhost + face - parent.begin] += alpha_ * (child.right / kAmrRatio - coarse);
+        }
+    }
+}
+
+void AmrSolver::averageDown(int level)
+{
+    for (const Block &child: levels_[level+1].blocks)
+    {
+        Block &parent = *findBlock(level, child.begin / kAmrRatio);
+        const double *fine = child.u.data() + kAmrGhost;
+        double *coarse = parent.u.data() + kAmrGhost - parent.begin;
+        for (std::int64_t k = child.begin; k < child.end; k += kAmrRatio)
+            coarse[k / kAmrRatio] = 0.5 * (fine[k - child.begin] + fine[k + 1 - child.begin]);
+    }
+}
+
+// Rebuilds the levels from the base up, each from the tags of the one below
+// as it now stands. Fine cells already present keep their values, new ones
+// are interpolated from the level below, or at the start taken from the
+// profile.
+void AmrSolver::regrid(bool initial_grid)
+{
+    TRACE_SCOPE("AmrSolver::regrid");
+    for (int level = 0; level + 1 < static_cast<int>(levels_.size()); ++level)
+    {
+        const std::vector<std::pair<std::int64_t, std::int64_t>> intervals = tagIntervals(level);
+        const double dx = param_.get_dx() / (std::int64_t(1) << (level + 1));
+
+        std::vector<Block> blocks;
+        blocks.reserve(intervals.size());
+        for (const auto &interval: intervals)
+        {
+            Block block;
+            block.begin = interval.first * kAmrRatio;
+            block.end = interval.second * kAmrRatio;
+            block.u.resize(block.end - block.begin + 2*kAmrGhost);
+            block.left = block.right = 0.0;
+            double *u = block.u.data() + kAmrGhost - block.begin;
+            for (std::int64_t k = block.begin; k < block.end; ++k)
+            {
+                const Block *previous = initial_grid ? nullptr : findBlock(level + 1, k);
+                if (initial_grid)
+                    u[k] = initial((k + 0.5) * dx, profile_);
+                else if (previous)
+                    u[k] = previous->u[kAmrGhost + k - previous->begin];
+                else
+                    u[k] = prolong(level + 1, k, 1.0);
+            }
+            blocks.push_back(std::move(block));
+        }
+        levels_[level+1].blocks.swap(blocks);
+
+        if (levels_[level+1].blocks.empty())
+        {
+            for (std::size_t l = level + 2; l < levels_.size(); ++l)
+                levels_[l].blocks.clear();
+            break;
+        }
+    }
+
+    for (int level = levels() - 2; level >= 0; --level)
+        averageDown(level);
+}
+
+std::vector<std::pair<std::int64_t, std::int64_t>> AmrSolver::tagIntervals(int level)
+{
+    std::vector<std::pair<std::int64_t, std::int64_t>> intervals;
+
+    // The thresholds come from the base grid, so that all levels refine the
+    // same features.
+    const Block &base = levels_[0].blocks.front();
+    const Reduction r = reduce(base.u.data() + kAmrGhost, base.end - base.begin);
+    const double threshold = std::min(settings_.gradient * (r.max - r.min),
+                                      settings_.variation * r.variation / (base.end - base.begin));
+    const double scale = static_cast<double>(std::int64_t(1) << level);
+
+    // The front moves alpha base cells a base step, so it stays within the
+    // buffer until the next regrid.
+    const std::int64_t buffer = static_cast<std::int64_t>(std::ceil(settings_.regrid_interval * alpha_ * scale)) + 1;
+    const Level &current = levels_[level];
+
+    for (Block &block: levels_[level].blocks)
+    {
+        fillGhosts(level, block, 1.0);
+        const double *u = block.u.data() + kAmrGhost - block.begin;
+        const std::int64_t low = block.begin == 0 ? 0 : block.begin + kAmrNesting;
+        const std::int64_t high = block.end == current.cells ? current.cells : block.end - kAmrNesting;
+        const std::size_t first = intervals.size();
+
+        for (std::int64_t k = block.begin; k < block.end; ++k)
+        {
+            const double jump = std::max(std::abs(u[k] - u[k-1]), std::abs(u[k+1] - u[k]));
+            if (!(jump * scale > threshold))
+                continue;
+            const std::int64_t begin = std::max(k - buffer, low);
+            const std::int64_t end = std::min(k + buffer + 1, high);
+            if (begin >= end)
+                continue;
+            // Merged with the last interval of this block when the gap is
+            // shorter than a block.
+            if (intervals.size() > first && begin - intervals.back().second < settings_.min_block)
+                intervals.back().second = std::max(intervals.back().second, end);
+            else
+                intervals.emplace_back(begin, end);
+        }
+    }
+    return intervals;
+}
+
+const AmrSolver::Block* AmrSolver::findBlock(int level, std::int64_t cell) const
+{
+    const std::vector<Block> &blocks = levels_[level].blocks;
+    auto it = std::upper_bound(blocks.begin(), blocks.end(), cell,
+                               [](std::int64_t c, const Block &b) { return c < b.begin; });
+    if (it == blocks.begin())
+        return nullptr;
+    --it;
+    return cell < it->end ? &*it : nullptr;
+}
+
+AmrSolver::Block* AmrSolver::findBlock(int level, std::int64_t cell)
+{
+    return const_cast<Block*>(static_cast<const AmrSolver*>(this)->findBlock(level, cell));
+}
+
+// Cells [begin, end) of block at the level, replaced by the blocks of the
+// next level where these cover them.
+void AmrSolver::emit(int level, const Block &block, std::int64_t begin, std::int64_t end,
+                     std::vector<double> &x, std::vector<double> &u, std::vector<double> &width) const
+{
+    const double dx = param_.get_dx() / (std::int64_t(1) << level);
+    const double *values = block.u.data() + kAmrGhost - block.begin;
+    auto append = [&](std::int64_t from, std::int64_t to) {
+        for (std::int64_t k = from; k < to; ++k)
+        {
+            x.push_back((k + 0.5) * dx);
+            u.push_back(values[k]);
+            width.push_back(dx);
+        }
+    };
+
+    std::int64_t cursor = begin;
+    if (level + 1 < levels())
+    {
+        for (const Block &child: levels_[level+1].blocks)
+        {
+            const std::int64_t child_begin = child.begin / kAmrRatio;
+            const std::int64_t child_end = child.end / kAmrRatio;
+            if (child_end <= begin || child_begin >= end)
+                continue;
+            append(cursor, child_begin);
+            emit(level + 1, child, child.begin, child.end, x, u, width);
+            cursor = child_end;
+        }
+    }
+    append(cursor, end);
+}
+
+void AmrSolver::record()
+{
+    std::vector<double> x, u, width;
+    composite(x, u, width);
+
+    Diagnostics d;
+    d.steps = steps_;
+    d.time = time();
+    Reduction r = emptyReduction();
+    for (std::size_t i = 0; i < u.size(); ++i)
+    {
+        accumulate(r, u[i], i > 0 ? u[i-1] : u[i]);
+        d.mass += u[i] * width[i];
+        d.energy += u[i] * u[i] * width[i];
+    }
+    d.min = r.min;
+    d.max = r.max;
+    d.variation = r.variation;
+    diagnostics_.add(d);
+}
@@ -0,0 +1,138 @@
+#ifndef AMR_H
+#define AMR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "diagnostics.h"
+#include "parameters.h"
+#include "profile.h"
+#include "scheme.h"
+
+// Refinement ratio between levels, in space and in time.
+constexpr int kAmrRatio = 2;
+// Ghost cells on either side of a block, as reconstructFaces() reads them.
+constexpr std::int64_t kAmrGhost = 3;
+// Cells of the coarser level kept between a block and the edge of the
+// block it is nested in, so that its ghost cells interpolate from interior
+// values only.
+constexpr std::int64_t kAmrNesting = 3;
+
+struct AmrSettings
+{
+    int levels = 3;                   // refined levels above the base grid
+    // A cell is tagged for refinement when the larger difference to its
+    // neighbours, scaled to the base spacing, exceeds gradient times the
+    // range max - min of the base grid, or variation times its mean
+    // difference TV / cells.
+    double gradient = 0.01;
+    double variation = 2.0;
+    std::int64_t min_block = 8;       // shortest gap between blocks, in cells of the coarser level
+    int regrid_interval = 4;          // base steps between regrids
+};
+
+// Methods in flux form with one stage: Upwind, LaxWendroff and the MUSCL
+// limiters, the latter with the slope traced along the characteristic over
+// the step (a single-step TVD scheme) instead of Runge-Kutta stages.
+bool isAmrMethod(MethodType type);
+
+// Block-structured adaptive mesh refinement of u_t + u_x = 0 over the cells
+// of the base grid of param (nx - 1 cells of dx, nt steps of dt). Each
+// refined level halves dx and dt and consists of disjoint blocks nested in
+// those of the level below, placed where the gradient or variation
+// indicators tag cells and regridded every regrid_interval base steps with
+// a buffer wide enough for the front to stay inside until the next regrid.
+//
+// A base step advances every level recursively, a level taking kAmrRatio
+// steps per step of the one below (subcycling); ghost cells of a refined
+// block interpolate the coarser level linearly in space and time. After
+// the substeps the fine fluxes through each coarse-fine face replace the
+// coarse one there (refluxing) and the fine cells are averaged onto the
+// coarse cells they cover, so the composite grid conserves mass exactly.
+// The inflow boundary holds initial(0); the outflow one extrapolates flat.
+class AmrSolver
+{
+public:
+    AmrSolver(const Parameters &param, InitialProfile profile, MethodType method,
+              const AmrSettings &settings = AmrSettings());
+
+    // One base step.
+    void step();
+    void run();
+
+    bool finished() const;
+    bool diverged() const;
+
+    const Parameters& parameters() const;
+    InitialProfile profile() const;
+    MethodType method() const;
+    std::int64_t steps() const;
+    double time() const;
+
+    // Levels holding at least one block, the base grid included.
+    int levels() const;
+    std::int64_t cells(int level) const;
+    // Cells over all levels, the work per base step being dominated by the
+    // finest ones.
+    std::int64_t cells() const;
+
+    // The leaf cells from left to right: the finest value available at
+    // each place, with the centre and width of its cell.
+    void composite(std::vector<double> &x, std::vector<double> &u, std::vector<double> &width) const;
+    // Of the composite grid, masses weighted by the cell widths.
+    const DiagnosticsSeries& diagnostics() const;
+
+private:
+    struct Block
+    {
+        std::int64_t begin, end;        // cells [begin, end) of the level
+        std::vector<double> u, old;     // with kAmrGhost ghost cells on either side
+        std::vector<double> flux;       // faces begin .. end of the last step
+        double left, right;             // fine fluxes summed over the substeps
+    };
+
+    struct Level
+    {
+        std::int64_t cells;             // of the whole domain at this spacing
+        std::vector<Block> blocks;      // ordered, disjoint, not adjacent
+    };
+
+    Parameters param_;
+    InitialProfile profile_;
+    MethodType method_;
+    AmrSettings settings_;
+    double alpha_;
+    double inflow_;
+    std::int64_t steps_;
+    std::vector<Level> levels_;
+    DiagnosticsSeries diagnostics_;
+
+    std::vector<double> faces_;
+
+    // Steps the level at theta of the step of the level below, then the
+    // levels above it.
+    void advance(int level, double theta);
+    void stepBlock(Block &block);
+    void fillGhosts(int level, Block &block, double theta) const;
+    // Cell of the level at theta between the start and end of its step.
+    double value(int level, std::int64_t cell, double theta) const;
+    // Cell of the level interpolated from the level below.
+    double prolong(int level, std::int64_t cell, double theta) const;
+    void reflux(int level);
+    void averageDown(int level);
+
+    void regrid(bool initial);
+    // Cells of the level to refine, grown by the buffer and merged into
+    // intervals nested in its blocks.
+    std::vector<std::pair<std::int64_t, std::int64_t>> tagIntervals(int level);
+
+    const Block* findBlock(int level, std::int64_t cell) const;
+    Block* findBlock(int level, std::int64_t cell);
+    void emit(int level, const Block &block, std::int64_t begin, std::int64_t end,
+              std::vector<double> &x, std::vector<double> &u, std::vector<double> &width) const;
+    void record();
+};
+
+#endif // AMR_H
@@ -0,0 +1,69 @@
+#include "blocking.h"
+
+#include <algorithm>
+
+void blockedSweep(const Field &in, Field &out, MethodType type, const Stencil &s,
+                  std::int64_t steps, std::size_t tile_width, Field &scratch, Field &tmp_scratch,
+                  std::vector<Reduction> *reductions)
+{
+    const std::size_t n = in.size();
+    // One cell beyond the steps the tile needs, so that the variation of its
+    // first cell can still be taken against a valid neighbour on the last step.
+    const std::size_t halo = static_cast<std::size_t>(steps) + 1;
+    if (scratch.size() < tile_width + 2*halo)
+    {
+        scratch = Field(tile_width + 2*halo);
+        tmp_scratch = Field(tile_width + 2*halo);
+    }
+    if (reductions)
+        reductions->assign(static_cast<std::size_t>(steps), emptyReduction());
+
+    for (std::size_t a = 0; a < n; a += tile_width)
+    {
+        std::size_t b = std::min(a + tile_width, n);
+        std::size_t lo = a > halo ? a - halo : 0;
+        std::size_t hi = std::min(b + halo, n);
+        std::size_t len = hi - lo;
+
+        std::copy(in.begin() + lo, in.begin() + hi, scratch.data());
+        std::fill(scratch.data() + len, scratch.data() + len + kGhost, in[hi-1]);
+        std::fill(scratch.data() - kGhost, scratch.data(), in[lo]);
+
+        // The fixed boundary cells are set rather than swept.
+        std::size_t first = lo == 0 ? 1 : 0;
+        std::size_t last = hi == n ? len - 1 : len;
+        std::size_t begin = std::max(a - lo, first);
+        std::size_t end = std::min(b - lo, last);
+
+        double *cur = scratch.data();
+        double *next = tmp_scratch.data();
+        for (std::int64_t step = 0; step < steps; ++step)
+        {
+            if (lo == 0)
+                next[0] = in[0];
+            if (hi == n)
+                next[len-1] = in[n-1];
+            if (!reductions)
+            {
+                sweep(cur + first, next + first, last - first, type, s);
+            }
+            else
+            {
+                // Only the cells this tile owns are counted.
+                Reduction &r = (*reductions)[static_cast<std::size_t>(step)];
+                sweep(cur + first, next + first, begin - first, type, s);
+                if (a == 0)
+                    accumulate(r, next[0], next[0]);
+                sweepReduce(cur, next, begin, end, type, s, r);
+                sweep(cur + end, next + end, last - end, type, s);
+                if (b == n)
+                    accumulate(r, next[len-1], next[len-2]);
+            }
+            next[-1] = cur[-1];
+            next[len] = cur[len];
+            std::swap(cur, next);
+        }
+
+        std::copy(cur + (a - lo), cur + (b - lo), out.data() + a);
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef BLOCKING_H
+#define BLOCKING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "field.h"
+#include "kernels.h"
+
+constexpr std::size_t kTileWidth = 4096;
+constexpr int kTileSteps = 32;
+
+// Advances in by steps time steps into out with trapezoid (ghost-zone) time
+// tiling: each tile of tile_width cells is copied together with steps cells
+// of halo on either side into two scratch buffers that stay in cache, swept
+// steps times while the valid region shrinks by one cell per side and step,
+// and its centre written to out. Boundary values are kept fixed, as in a
+// plain sweep. out's ghost cells are left untouched. If reductions is given,
+// it receives the Reduction of every intermediate state, one per step, taken
+// inside the tile sweeps.
+void blockedSweep(const Field &in, Field &out, MethodType type, const Stencil &s,
+                  std::int64_t steps, std::size_t tile_width, Field &scratch, Field &tmp_scratch,
+                  std::vector<Reduction> *reductions = nullptr);
+
+#endif // BLOCKING_H
@@ -0,0 +1,180 @@
+#include "convergence.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "threadpool.h"
+
+// Fixed boundaries hold u(0) at inflow, so the exact solution is initial(0)
+// behind the front coming in from the left; periodic ones wrap around.
+static double exactSolution(double x, double t, InitialProfile profile, bool periodic)
+{
+    if (periodic)
+        return initial(x - kRangeX * std::floor((x - t) / kRangeX) - t, profile);
+    return x >= t ? initial(x - t, profile) : initial(0.0, profile);
+}
+
+ErrorNorms solutionError(const Solver &solver)
+{
+    const Parameters &param = solver.parameters();
+    const double dx = param.get_dx();
+    const double t = solver.time();
+    const bool periodic = solver.periodicBoundaries();
+    const Field &state = solver.state();
+    std::size_t cells = state.size() - 1;
+    if (!periodic)
+        cells = std::min(cells, static_cast<std::size_t>(std::ceil((kRangeX - kOutflowLayer) / dx)));
+
+    ErrorNorms error = {0.0, 0.0, 0.0};
+    for (std::size_t i = 0; i < cells; ++i)
+    {
+        double e = std::abs(state[i] - exactSolution(i * dx, t, solver.profile(), periodic));
+        error.l1 += e;
+        error.l2 += e * e;
+        error.linf = std::max(error.linf, e);
+    }
+    error.l1 *= dx;
+    error.l2 = std::sqrt(error.l2 * dx);
+    return error;
+}
+
+std::vector<SweepCase> refinementLadder(const std::vector<InitialProfile> &profiles, const std::vector<MethodType> &methods,
+                                        std::int64_t nx, std::int64_t nt, int levels)
+{
+    std::vector<SweepCase> cases;
+    for (auto profile: profiles)
+        for (auto method: methods)
+            for (int level = 0; level < levels; ++level)
+                cases.push_back(SweepCase{profile, method, ((nx-1) << level) + 1, nt << level});
+    return cases;
+}
+
+static ConvergenceResult runCase(const SweepCase &run, int repeats)
+{
+    ConvergenceResult result;
+    result.run = run;
+    result.seconds = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < std::max(1, repeats); ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Solver solver(Parameters(run.nx, run.nt, kRangeX, kRangeT), run.profile, run.method);
+        solver.run();
+        auto finish = std::chrono::steady_clock::now();
+        result.seconds = std::min(result.seconds, std::chrono::duration<double>(finish - start).count());
+
+        result.alpha = solver.parameters().get_alpha();
+        result.diverged = solver.diverged();
+        result.error = solutionError(solver);
+    }
+    return result;
+}
+
+std::vector<ConvergenceResult> runConvergence(const std::vector<SweepCase> &cases, unsigned threads, int repeats)
+{
+    std::vector<ConvergenceResult> results(cases.size());
+
+    std::vector<std::size_t> order(cases.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&cases](std::size_t a, std::size_t b) {
+        return static_cast<double>(cases[a].nx) * cases[a].nt > static_cast<double>(cases[b].nx) * cases[b].nt;
+    });
+
+    ThreadPool pool(threads);
+    for (auto index: order)
+        pool.submit([&cases, &results, index, repeats] { results[index] = runCase(cases[index], repeats); });
+    pool.wait();
+
+    return results;
+}
+
+// Indices of the results of every (profile, method) pair, coarsest first.
+static std::map<std::pair<int, int>, std::vector<std::size_t>> groupByScheme(const std::vector<ConvergenceResult> &results)
+{
+    std::map<std::pair<int, int>, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < results.size(); ++i)
+        groups[std::make_pair(results[i].run.profile, results[i].run.method)].push_back(i);
+    for (auto &group: groups)
+    {
+        std::stable_sort(group.second.begin(), group.second.end(), [&results](std::size_t a, std::size_t b) {
+            return results[a].run.nx < results[b].run.nx;
+        });
+    }
+    return groups;
+}
+
+static double order(double coarse_error, double fine_error, double coarse_dx, double fine_dx)
+{
+    return std::log(coarse_error / fine_error) / std::log(coarse_dx / fine_dx);
+}
+
+void writeConvergenceTable(std::ostream &out, const std::vector<ConvergenceResult> &results)
+{
+    out.precision(6);
+    out << "profile\tmethod\tnx\tnt\talpha\tdiverged\tl1\tl2\tlinf\torder_l1\torder_l2\torder_linf\tseconds\n";
+    for (const auto &group: groupByScheme(results))
+    {
+        const ConvergenceResult *coarse = nullptr;
+        for (auto index: group.second)
+        {
+            const ConvergenceResult &result = results[index];
+            double dx = kRangeX / (result.run.nx - 1);
+            out << profileName(result.run.profile) << "\t" << methodName(result.run.method) << "\t"
+                << result.run.nx << "\t" << result.run.nt << "\t" << result.alpha << "\t"
+                << (result.diverged ? 1 : 0) << "\t"
+                << result.error.l1 << "\t" << result.error.l2 << "\t" << result.error.linf << "\t";
+            if (coarse && coarse->run.nx != result.run.nx)
+            {
+                double coarse_dx = kRangeX / (coarse->run.nx - 1);
+                out << order(coarse->error.l1, result.error.l1, coarse_dx, dx) << "\t"
+                    << order(coarse->error.l2, result.error.l2, coarse_dx, dx) << "\t"
+                    << order(coarse->error.linf, result.error.linf, coarse_dx, dx) << "\t";
+            }
+            else
+                out << "\t\t\t";
+            out << result.seconds << "\n";
+            coarse = &result;
+        }
+    }
+}
+
+void writeWorkPrecision(std::ostream &out, const std::vector<ConvergenceResult> &results, double target)
+{
+    out.precision(6);
+    out << "profile\tmethod\ttarget_l2\tseconds\tnx\n";
+    for (const auto &group: groupByScheme(results))
+    {
+        const ConvergenceResult *above = nullptr, *reached = nullptr;
+        for (auto index: group.second)
+        {
+            const ConvergenceResult &result = results[index];
+            if (result.diverged)
+                continue;
+            if (result.error.l2 <= target)
+            {
+                reached = &result;
+                break;
+            }
+            above = &result;
+        }
+
+        out << profileName(static_cast<InitialProfile>(group.first.first)) << "\t"
+            << methodName(static_cast<MethodType>(group.first.second)) << "\t" << target << "\t";
+        if (!reached)
+        {
+            out << "-\t-\n";
+            continue;
+        }
+        double seconds = reached->seconds;
+        if (above && above->error.l2 > reached->error.l2 && reached->error.l2 > 0.0)
+        {
+            double fraction = std::log(above->error.l2 / target) / std::log(above->error.l2 / reached->error.l2);
+            seconds = above->seconds * std::pow(reached->seconds / above->seconds, fraction);
+        }
+        out << seconds << "\t" << reached->run.nx << "\n";
+    }
+}
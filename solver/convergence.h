@@ -0,0 +1,56 @@
+#ifndef CONVERGENCE_H
+#define CONVERGENCE_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "solver.h"
+#include "sweep.h"
+
+struct ErrorNorms
+{
+    double l1, l2, linf;
+};
+
+// Width left out of the norms at the outflow edge of fixed boundaries. The
+// edge is held fixed rather than solved for, and the error that causes
+// spreads upstream; it does not shrink with the grid spacing.
+constexpr double kOutflowLayer = kRangeX / 10.0;
+
+// Error of the current state against the exact solution, initial() shifted
+// by c*t with c = 1: periodic when the solver's boundaries are, leaving out
+// cell n-1 as the image of cell 0, otherwise with the fixed inflow value,
+// leaving out kOutflowLayer.
+ErrorNorms solutionError(const Solver &solver);
+
+struct ConvergenceResult
+{
+    SweepCase run;
+    double alpha;
+    bool diverged;
+    ErrorNorms error;
+    double seconds;
+};
+
+// For every profile and method, levels grids starting at (nx, nt) with the
+// spacing halved each level; alpha stays the same on all of them.
+std::vector<SweepCase> refinementLadder(const std::vector<InitialProfile> &profiles, const std::vector<MethodType> &methods,
+                                        std::int64_t nx, std::int64_t nt, int levels);
+
+// Runs every case to kRangeT on a work-stealing pool and measures the error.
+// seconds is the best of repeats runs; concurrent runs share memory
+// bandwidth, so use threads = 1 for timings that compare well across grids.
+std::vector<ConvergenceResult> runConvergence(const std::vector<SweepCase> &cases, unsigned threads = 0, int repeats = 1);
+
+// One row per result. The order columns compare each run with the previous
+// coarser one of the same profile and method, log(e1/e2) / log(dx1/dx2),
+// and are empty on the coarsest level.
+void writeConvergenceTable(std::ostream &out, const std::vector<ConvergenceResult> &results);
+
+// Work-precision summary: for every profile and method, the time needed to
+// reach target in the L2 norm, interpolated log-log between the two runs
+// around it, or "-" when no run gets there.
+void writeWorkPrecision(std::ostream &out, const std::vector<ConvergenceResult> &results, double target);
+
+#endif // CONVERGENCE_H
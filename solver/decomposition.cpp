@@ -0,0 +1,238 @@
+#include "decomposition.h"
+
+#include <algorithm>
+
+#include "trace.h"
+
+DomainDecomposition::DomainDecomposition(std::size_t n, MethodType method, const Stencil &s, bool periodic,
+                                         unsigned threads)
+    : n_(n), method_(method), stencil_(s), periodic_(periodic), job_(Advance), source_(nullptr), target_(nullptr), steps_(0),
+      generation_(0), running_(0), stop_(false)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    // Every subdomain must hold a full halo for its neighbours.
+    const std::size_t cells = periodic_ ? n_ - 1 : n_;
+    const std::size_t count = std::max<std::size_t>(1, std::min<std::size_t>(threads, cells / kHaloCells));
+
+    flags_.reset(new Flag[count]);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::unique_ptr<Subdomain> d(new Subdomain);
+        d->begin = cells * i / count;
+        d->end = cells * (i+1) / count;
+        d->exchanges = 0;
+        subdomains_.push_back(std::move(d));
+        flags_[i].value.store(0, std::memory_order_relaxed);
+    }
+    for (unsigned i = 0; i < count; ++i)
+        workers_.emplace_back(&DomainDecomposition::work, this, i);
+}
+
+DomainDecomposition::~DomainDecomposition()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker: workers_)
+        worker.join();
+}
+
+std::size_t DomainDecomposition::size() const
+{
+    return n_;
+}
+
+unsigned DomainDecomposition::threads() const
+{
+    return static_cast<unsigned>(workers_.size());
+}
+
+bool DomainDecomposition::periodic() const
+{
+    return periodic_;
+}
+
+void DomainDecomposition::load(const double *u)
+{
+    TRACE_SCOPE("DomainDecomposition::load");
+    dispatch(Load, u, nullptr, 0);
+}
+
+void DomainDecomposition::advance(std::int64_t steps, std::vector<Reduction> &reductions)
+{
+    TRACE_SCOPE("DomainDecomposition::advance");
+    reductions.clear();
+    if (steps <= 0)
+        return;
+    dispatch(Advance, nullptr, nullptr, steps);
+
+    reductions.assign(static_cast<std::size_t>(steps), emptyReduction());
+    for (const auto &d: subdomains_)
+    {
+        for (std::size_t i = 0; i < reductions.size(); ++i)
+            merge(reductions[i], d->reductions[i]);
+    }
+}
+
+void DomainDecomposition::store(double *u)
+{
+    TRACE_SCOPE("DomainDecomposition::store");
+    dispatch(Store, nullptr, u, 0);
+}
+
+void DomainDecomposition::dispatch(Job job, const double *source, double *target, std::int64_t steps)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_ = job;
+    source_ = source;
+    target_ = target;
+    steps_ = steps;
+    running_ = threads();
+    ++generation_;
+    wake_.notify_all();
+    done_.wait(lock, [this] { return running_ == 0; });
+}
+
+// The subdomain is allocated here, by the thread that will sweep it.
+void DomainDecomposition::work(unsigned index)
+{
+    Subdomain &d = *subdomains_[index];
+    d.u = Field(d.end - d.begin + 2*kHaloCells);
+    d.v = Field(d.end - d.begin + 2*kHaloCells);
+
+    std::int64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+            if (stop_)
+                return;
+            seen = generation_;
+        }
+
+        run(index);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--running_ == 0)
+            done_.notify_all();
+    }
+}
+
+void DomainDecomposition::run(unsigned index)
+{
+    Subdomain &d = *subdomains_[index];
+    const std::size_t m = d.end - d.begin;
+    const std::size_t w = kHaloCells;
+
+    if (job_ == Load)
+    {
+        std::copy(source_ + d.begin, source_ + d.end, d.u.data() + w);
+        // The fixed boundary cells are never swept, so the other buffer
+        // must hold them too.
+        if (!periodic_ && index == 0)
+            d.v[w] = d.u[w];
+        if (!periodic_ && index + 1 == threads())
+            d.v[w+m-1] = d.u[w+m-1];
+        return;
+    }
+    if (job_ == Store)
+    {
+        std::copy(d.u.data() + w, d.u.data() + w + m, target_ + d.begin);
+        if (periodic_ && index == 0)
+            target_[n_-1] = d.u[w];
+        return;
+    }
+
+    TRACE_SCOPE("DomainDecomposition::run");
+    d.reductions.resize(static_cast<std::size_t>(steps_));
+    for (std::int64_t done = 0; done < steps_; )
+    {
+        const std::int64_t period = std::min(kHaloSteps, steps_ - done);
+        exchange(index);
+        for (std::int64_t s = 0; s < period; ++s)
+        {
+            d.reductions[done + s] = sweepSubdomain(index, period - s - 1);
+            d.u.swap(d.v);
+        }
+        done += period;
+    }
+}
+
+// Publishes the edge cells into the outbox of this exchange's parity and
+// fills the halos from the neighbours' outboxes once they have published
+// theirs. A neighbour reuses an outbox two exchanges later, which it can
+// only reach after this subdomain has published the next one, that is
+// after it has read this one.
+void DomainDecomposition::exchange(unsigned index)
+{
+    Subdomain &d = *subdomains_[index];
+    const std::size_t m = d.end - d.begin;
+    const std::int64_t k = d.exchanges++;
+    const int parity = static_cast<int>(k % 2);
+    const unsigned count = threads();
+
+    double *u = d.u.data();
+    std::copy(u + kHaloCells, u + 2*kHaloCells, d.outbox[parity][0]);
+    std::copy(u + m, u + m + kHaloCells, d.outbox[parity][1]);
+    flags_[index].value.store(k + 1, std::memory_order_release);
+
+    auto await = [this, k](unsigned neighbour) -> const Subdomain& {
+        while (flags_[neighbour].value.load(std::memory_order_acquire) <= k)
+            std::this_thread::yield();
+        return *subdomains_[neighbour];
+    };
+    if (index > 0 || periodic_)
+    {
+        const Subdomain &left = await(index > 0 ? index - 1 : count - 1);
+        std::copy(left.outbox[parity][1], left.outbox[parity][1] + kHaloCells, u);
+    }
+    if (index + 1 < count || periodic_)
+    {
+        const Subdomain &right = await(index + 1 < count ? index + 1 : 0);
+        std::copy(right.outbox[parity][0], right.outbox[parity][0] + kHaloCells, u + kHaloCells + m);
+    }
+}
+
+// One step of the owned cells and of as much of the halo as the remaining
+// steps before the next exchange still need, plus the periodic image cell.
+// The Reduction covers the owned cells the way Solver::step() takes it: no
+// variation for cell 0, and for periodic grids cell n-1 once more after
+// cell n-2.
+Reduction DomainDecomposition::sweepSubdomain(unsigned index, std::int64_t remaining)
+{
+    Subdomain &d = *subdomains_[index];
+    const std::size_t m = d.end - d.begin;
+    const bool first = index == 0;
+    const bool last = index + 1 == threads();
+    const double *in = d.u.data();
+    double *out = d.v.data();
+
+    const std::size_t w = kHaloCells;
+    const std::size_t owned_begin = first ? w + 1 : w;
+    const std::size_t owned_end = last && !periodic_ ? w + m - 1 : w + m;
+    std::size_t lo = w - remaining - 1;
+    std::size_t hi = w + m + remaining + 1;
+    if (first && !periodic_)
+        lo = owned_begin;
+    if (last && !periodic_)
+        hi = owned_end;
+
+    Reduction r = emptyReduction();
+    if (lo < owned_begin)
+        sweep(in + lo, out + lo, owned_begin - lo, method_, stencil_);
+    if (first)
+        accumulate(r, out[w], out[w]);
+    if (owned_begin < owned_end)
+        sweepReduce(in, out, owned_begin, owned_end, method_, stencil_, r);
+    if (owned_end < hi)
+        sweep(in + owned_end, out + owned_end, hi - owned_end, method_, stencil_);
+    if (last && periodic_)
+        accumulate(r, out[w+m], out[w+m-1]);
+    if (last && !periodic_)
+        accumulate(r, out[w+m-1], out[w+m-2]);
+    return r;
+}
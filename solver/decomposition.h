@@ -0,0 +1,106 @@
+#ifndef DECOMPOSITION_H
+#define DECOMPOSITION_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "field.h"
+#include "kernels.h"
+#include "scheme.h"
+
+// Grids below this many cells stay on one thread.
+constexpr std::size_t kDecomposeCells = std::size_t(1) << 18;
+// Steps between halo exchanges. A subdomain carries a halo of kHaloCells
+// on either side, enough for kHaloSteps steps plus the periodic image
+// cell, rounded to a cache line of doubles so that its own cells stay
+// aligned; the part of the halo it needs shrinks by one cell per side and
+// step and is recomputed redundantly.
+constexpr std::int64_t kHaloSteps = 16;
+constexpr std::size_t kHaloCells = kHaloSteps + 8;
+// Steps per Solver::run() chunk, between blow-up checks.
+constexpr std::int64_t kDecompositionSteps = 16 * kHaloSteps;
+
+// One run of a stencil scheme split into contiguous subdomains, one per
+// thread. Each thread owns its subdomain for the lifetime of the object and
+// allocates it itself, so that on NUMA systems its pages land on the node
+// the thread runs on (first touch). Neighbours synchronize point to point:
+// at every exchange a subdomain publishes its edge cells and a counter, and
+// waits only for the counters of the two next to it, never for all.
+//
+// Boundaries are fixed, as in Solver::step(), or periodic with cell n-1 the
+// image of cell 0, in which case the ring of n-1 cells is decomposed.
+class DomainDecomposition
+{
+public:
+    // threads as for ThreadPool: 0 means one per core.
+    DomainDecomposition(std::size_t n, MethodType method, const Stencil &s, bool periodic, unsigned threads = 0);
+    ~DomainDecomposition();
+
+    DomainDecomposition(const DomainDecomposition&) = delete;
+    DomainDecomposition& operator=(const DomainDecomposition&) = delete;
+
+    std::size_t size() const;
+    unsigned threads() const;
+    bool periodic() const;
+
+    // The subdomains hold the state between calls: load() copies it in from
+    // the whole grid u and store() back out, each thread its own cells, so
+    // a run loads once and stores only when the grid is read.
+    void load(const double *u);
+    // reductions receives one Reduction per step, as the stencil pass of
+    // Solver::step() gives it.
+    void advance(std::int64_t steps, std::vector<Reduction> &reductions);
+    void store(double *u);
+
+private:
+    struct Subdomain
+    {
+        std::size_t begin, end;             // owned cells of the grid or ring
+        Field u, v;                         // owned cells with kHaloCells on either side
+        double outbox[2][2][kHaloCells];    // edge cells by exchange parity, left and right
+        std::int64_t exchanges;
+        std::vector<Reduction> reductions;
+    };
+
+    // Exchanges published, one per cache line.
+    struct Flag
+    {
+        std::atomic<std::int64_t> value;
+        char padding[64 - sizeof(std::atomic<std::int64_t>)];
+    };
+
+    std::size_t n_;
+    MethodType method_;
+    Stencil stencil_;
+    bool periodic_;
+    std::vector<std::unique_ptr<Subdomain>> subdomains_;
+    std::unique_ptr<Flag[]> flags_;
+    std::vector<std::thread> workers_;
+
+    enum Job {Load, Advance, Store};
+
+    Job job_;
+    const double *source_;
+    double *target_;
+    std::int64_t steps_;
+    std::int64_t generation_;
+    unsigned running_;
+    bool stop_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    void dispatch(Job job, const double *source, double *target, std::int64_t steps);
+    void work(unsigned index);
+    void run(unsigned index);
+    void exchange(unsigned index);
+    Reduction sweepSubdomain(unsigned index, std::int64_t remaining);
+};
+
+#endif // DECOMPOSITION_H
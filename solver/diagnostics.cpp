@@ -0,0 +1,98 @@
+#include "diagnostics.h"
+
+#include <algorithm>
+#include <cmath>
+
+Diagnostics summarize(const Reduction &r, double dx, std::int64_t steps, double time)
+{
+    Diagnostics d;
+    d.steps = steps;
+    d.time = time;
+    d.min = r.min;
+    d.max = r.max;
+    d.mass = r.sum * dx;
+    d.energy = r.sum_squares * dx;
+    d.variation = r.variation;
+    return d;
+}
+
+Reduction reduce(const double *u, std::size_t n)
+{
+    Reduction r = emptyReduction();
+    for (std::size_t i = 0; i < n; ++i)
+        accumulate(r, u[i], i > 0 ? u[i-1] : u[i]);
+    return r;
+}
+
+bool blownUp(const Diagnostics &d)
+{
+    return !(d.max <= kBlowUpLimit && d.min >= -kBlowUpLimit && std::isfinite(d.energy));
+}
+
+DiagnosticsSeries::DiagnosticsSeries()
+    : empty_(true), stride_(1), next_(0)
+{
+}
+
+void DiagnosticsSeries::add(const Diagnostics &sample)
+{
+    latest_ = sample;
+    empty_ = false;
+    if (sample.steps < next_)
+        return;
+
+    if (samples_.size() >= kDiagnosticsSamples)
+    {
+        for (std::size_t i = 0; 2*i < samples_.size(); ++i)
+            samples_[i] = samples_[2*i];
+        samples_.resize((samples_.size() + 1) / 2);
+        stride_ *= 2;
+    }
+    samples_.push_back(sample);
+    next_ = sample.steps + stride_;
+}
+
+void DiagnosticsSeries::clear()
+{
+    samples_.clear();
+    latest_ = Diagnostics();
+    empty_ = true;
+    stride_ = 1;
+    next_ = 0;
+}
+
+bool DiagnosticsSeries::empty() const
+{
+    return empty_;
+}
+
+const Diagnostics& DiagnosticsSeries::latest() const
+{
+    return latest_;
+}
+
+const std::vector<Diagnostics>& DiagnosticsSeries::samples() const
+{
+    return samples_;
+}
+
+std::int64_t DiagnosticsSeries::stride() const
+{
+    return stride_;
+}
+
+std::vector<Diagnostics> DiagnosticsSeries::reduced(std::size_t max_points) const
+{
+    std::vector<Diagnostics> points;
+    if (empty_ || max_points == 0)
+        return points;
+
+    // One slot is kept for the latest sample.
+    std::size_t slots = max_points - 1;
+    std::size_t stride = slots > 0 ? std::max<std::size_t>(1, (samples_.size() + slots - 1) / slots) : samples_.size() + 1;
+    for (std::size_t i = 0; i < samples_.size() && points.size() < slots; i += stride)
+        points.push_back(samples_[i]);
+    if (points.empty() || points.back().steps != latest_.steps)
+        points.push_back(latest_);
+    return points;
+}
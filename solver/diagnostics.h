@@ -0,0 +1,60 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "kernels.h"
+
+constexpr double kBlowUpLimit = 10.0;
+
+// Physical summary of one state. The sums come out of the stencil pass that
+// produced the state (see sweepReduce), so monitoring costs no extra pass.
+struct Diagnostics
+{
+    std::int64_t steps = 0;
+    double time = 0.0;
+    double min = 0.0, max = 0.0;
+    double mass = 0.0;          // sum of u*dx
+    double energy = 0.0;        // sum of u^2*dx
+    double variation = 0.0;     // sum of |u[i] - u[i-1]|
+};
+
+Diagnostics summarize(const Reduction &r, double dx, std::int64_t steps, double time);
+
+// The same sums in a separate pass, for states that no sweep produced.
+Reduction reduce(const double *u, std::size_t n);
+
+// Beyond kBlowUpLimit, or no longer finite.
+bool blownUp(const Diagnostics &d);
+
+// Per-step time series in bounded memory: once kDiagnosticsSamples samples
+// are held, every other one is dropped and from then on only every
+// stride()-th step is kept. The latest sample is always available.
+constexpr std::size_t kDiagnosticsSamples = std::size_t(1) << 16;
+
+class DiagnosticsSeries
+{
+public:
+    DiagnosticsSeries();
+
+    void add(const Diagnostics &sample);
+    void clear();
+
+    bool empty() const;
+    const Diagnostics& latest() const;
+    const std::vector<Diagnostics>& samples() const;
+    std::int64_t stride() const;
+
+    // At most max_points evenly spaced samples, ending with the latest.
+    std::vector<Diagnostics> reduced(std::size_t max_points) const;
+
+private:
+    std::vector<Diagnostics> samples_;
+    Diagnostics latest_;
+    bool empty_;
+    std::int64_t stride_, next_;
+};
+
+#endif // DIAGNOSTICS_H
@@ -0,0 +1,94 @@
+#include "ensemble.h"
+
+#include <algorithm>
+
+#include "kernels.h"
+#include "parameters.h"
+
+Ensemble::Ensemble(std::int64_t nx, const std::vector<EnsembleMember> &members)
+    : nx_(nx), members_(members),
+      stride_((members.size() + kEnsembleAlignment - 1) / kEnsembleAlignment * kEnsembleAlignment),
+      state_(static_cast<std::size_t>(nx) * stride_, 0.0),
+      left_(stride_, 0.0), centre_(stride_, 1.0), right_(stride_, 0.0),
+      steps_(0), max_nt_(0)
+{
+    for (std::size_t m = 0; m < members_.size(); ++m)
+    {
+        Parameters param(nx_, members_[m].nt, kRangeX, kRangeT);
+        std::vector<double> initial = initialState(param, members_[m].profile);
+        for (std::size_t i = 0; i < initial.size(); ++i)
+            state_[i*stride_ + m] = initial[i];
+
+        Stencil s = stencil(members_[m].method, param.get_alpha());
+        left_[m] = s.left;
+        centre_[m] = s.centre;
+        right_[m] = s.right;
+        max_nt_ = std::max(max_nt_, members_[m].nt);
+        if (members_[m].nt <= 0)
+            retire(m);
+    }
+    tmp_state_ = state_;
+}
+
+void Ensemble::step()
+{
+    ensembleSweep(state_.data(), tmp_state_.data(), static_cast<std::size_t>(nx_), stride_,
+                  left_.data(), centre_.data(), right_.data());
+    state_.swap(tmp_state_);
+    ++steps_;
+
+    for (std::size_t m = 0; m < members_.size(); ++m)
+        if (members_[m].nt == steps_)
+            retire(m);
+}
+
+void Ensemble::run()
+{
+    while (!finished())
+        step();
+}
+
+bool Ensemble::finished() const
+{
+    return steps_ >= max_nt_;
+}
+
+std::size_t Ensemble::size() const
+{
+    return members_.size();
+}
+
+std::int64_t Ensemble::nx() const
+{
+    return nx_;
+}
+
+const EnsembleMember& Ensemble::member(std::size_t m) const
+{
+    return members_[m];
+}
+
+std::int64_t Ensemble::steps(std::size_t m) const
+{
+    return std::min(steps_, members_[m].nt);
+}
+
+double Ensemble::alpha(std::size_t m) const
+{
+    return Parameters(nx_, members_[m].nt, kRangeX, kRangeT).get_alpha();
+}
+
+std::vector<double> Ensemble::state(std::size_t m) const
+{
+    std::vector<double> values(static_cast<std::size_t>(nx_));
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = state_[i*stride_ + m];
+    return values;
+}
+
+void Ensemble::retire(std::size_t m)
+{
+    left_[m] = 0.0;
+    centre_[m] = 1.0;
+    right_[m] = 0.0;
+}
@@ -0,0 +1,51 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "profile.h"
+#include "scheme.h"
+
+struct EnsembleMember
+{
+    InitialProfile profile;
+    MethodType method;
+    std::int64_t nt;
+};
+
+// Many independent runs on the same grid advanced together. Cell i of every
+// member is stored contiguously ([cell][member]), so each step is a single
+// pass in which the update vectorizes across members. Each member has its
+// own profile, stencil scheme (not Spectral) and step count; a member that
+// has reached its nt gets the identity stencil and simply stays put.
+class Ensemble
+{
+public:
+    Ensemble(std::int64_t nx, const std::vector<EnsembleMember> &members);
+
+    void step();
+    void run();
+
+    bool finished() const;
+    std::size_t size() const;
+    std::int64_t nx() const;
+    const EnsembleMember& member(std::size_t m) const;
+    std::int64_t steps(std::size_t m) const;
+    double alpha(std::size_t m) const;
+    std::vector<double> state(std::size_t m) const;
+
+private:
+    std::int64_t nx_;
+    std::vector<EnsembleMember> members_;
+    std::size_t stride_;
+    std::vector<double> state_, tmp_state_;
+    std::vector<double> left_, centre_, right_;
+    std::int64_t steps_;
+    std::int64_t max_nt_;
+
+    void retire(std::size_t m);
+};
+
+#endif // ENSEMBLE_H
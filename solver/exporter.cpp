@@ -0,0 +1,284 @@
+#include "exporter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include "trace.h"
+
+static const char* const kExportFormatNames[] = {"binary", "csv"};
+
+const char* exportFormatName(ExportFormat format)
+{
+    return kExportFormatNames[format];
+}
+
+bool exportFormatFromName(const std::string &name, ExportFormat *format)
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        if (name == kExportFormatNames[i])
+        {
+            *format = static_cast<ExportFormat>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string diagnosticsPath(const std::string &path)
+{
+    const std::string suffix = ".csv";
+    if (path.size() > suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0)
+        return path.substr(0, path.size() - suffix.size()) + "_diagnostics.csv";
+    return path + ".diagnostics.csv";
+}
+
+std::int64_t exportStride(std::int64_t nt)
+{
+    return std::max<std::int64_t>(1, nt / kExportSnapshots);
+}
+
+static std::string metadata(const Solver &solver)
+{
+    const Parameters &param = solver.parameters();
+    std::ostringstream out;
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "nx " << param.get_nx() << "\n"
+        << "nt " << param.get_nt() << "\n"
+        << "dx " << param.get_dx() << "\n"
+        << "dt " << param.get_dt() << "\n"
+        << "alpha " << param.get_alpha() << "\n"
+        << "method " << methodName(solver.method()) << "\n"
+        << "profile " << profileName(solver.profile()) << "\n";
+    return out.str();
+}
+
+template <typename T>
+static void writeRaw(std::ofstream &out, const T &value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+Exporter::Exporter()
+    : format_(ExportBinary), stride_(1), last_(-1), dx_(0.0), wait_(false),
+      closing_(false), failed_(false), written_(0), dropped_(0)
+{
+}
+
+Exporter::~Exporter()
+{
+    if (writer_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closing_ = true;
+        }
+        queued_.notify_one();
+        writer_.join();
+    }
+}
+
+bool Exporter::open(const std::string &path, ExportFormat format, const Solver &solver, std::int64_t stride, bool wait)
+{
+    if (writer_.joinable())
+        return false;
+
+    out_.open(path, format == ExportBinary ? std::ios::binary | std::ios::trunc : std::ios::trunc);
+    if (format == ExportCsv)
+        diagnostics_.open(diagnosticsPath(path), std::ios::trunc);
+    if (!out_ || (format == ExportCsv && !diagnostics_))
+    {
+        out_.close();
+        diagnostics_.close();
+        return false;
+    }
+
+    format_ = format;
+    stride_ = std::max<std::int64_t>(stride, 1);
+    last_ = -1;
+    dx_ = solver.parameters().get_dx();
+    wait_ = wait;
+    closing_ = failed_ = false;
+    written_ = dropped_ = 0;
+    queue_.clear();
+    free_.assign(kExportQueue, std::vector<double>(solver.state().size()));
+
+    std::string header = metadata(solver);
+    if (format_ == ExportBinary)
+    {
+        out_.write("TEEXPORT", 8);
+        writeRaw(out_, static_cast<std::uint32_t>(header.size()));
+        out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+    else
+    {
+        std::istringstream lines(header);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            out_ << "# " << line << "\n";
+            diagnostics_ << "# " << line << "\n";
+        }
+        out_ << "steps,t,x,u\n";
+        out_.precision(std::numeric_limits<double>::max_digits10);
+    }
+
+    writer_ = std::thread(&Exporter::work, this);
+    return true;
+}
+
+bool Exporter::isOpen() const
+{
+    return writer_.joinable();
+}
+
+std::int64_t Exporter::stride() const
+{
+    return stride_;
+}
+
+std::int64_t Exporter::nextStep(std::int64_t steps) const
+{
+    return (steps / stride_ + 1) * stride_;
+}
+
+void Exporter::append(const Solver &solver, bool force)
+{
+    std::int64_t steps = solver.steps();
+    if (!isOpen() || steps == last_ || (steps % stride_ != 0 && !force))
+        return;
+    TRACE_SCOPE("Exporter::append");
+    last_ = steps;
+
+    Frame frame;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (free_.empty() && !wait_)
+        {
+            ++dropped_;
+            return;
+        }
+        freed_.wait(lock, [this] { return !free_.empty(); });
+        frame.values.swap(free_.back());
+        free_.pop_back();
+    }
+
+    // The copy is all the time loop pays for.
+    const Field &state = solver.state();
+    frame.steps = steps;
+    frame.time = solver.time();
+    std::copy(state.begin(), state.end(), frame.values.begin());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(frame));
+    }
+    queued_.notify_one();
+}
+
+bool Exporter::finish(const DiagnosticsSeries &series)
+{
+    if (!isOpen())
+        return false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+    queued_.notify_one();
+    writer_.join();
+
+    writeDiagnostics(series);
+    if (format_ == ExportBinary)
+        out_.write("END ", 4);
+    bool ok = !failed_ && out_.good() && (format_ != ExportCsv || diagnostics_.good());
+    out_.close();
+    diagnostics_.close();
+    out_.clear();
+    diagnostics_.clear();
+    return ok;
+}
+
+std::int64_t Exporter::written() const
+{
+    return written_;
+}
+
+std::int64_t Exporter::dropped() const
+{
+    return dropped_;
+}
+
+void Exporter::work()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;)
+    {
+        queued_.wait(lock, [this] { return closing_ || !queue_.empty(); });
+        if (queue_.empty())
+            return;
+        Frame frame = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+
+        // After a failed write the rest is only drained.
+        if (!failed_)
+        {
+            writeFrame(frame);
+            failed_ = !out_.good();
+        }
+
+        lock.lock();
+        ++written_;
+        free_.push_back(std::move(frame.values));
+        freed_.notify_one();
+    }
+}
+
+void Exporter::writeFrame(const Frame &frame)
+{
+    TRACE_SCOPE("Exporter::writeFrame");
+    std::int64_t n = static_cast<std::int64_t>(frame.values.size());
+    if (format_ == ExportBinary)
+    {
+        out_.write("SNAP", 4);
+        writeRaw(out_, frame.steps);
+        writeRaw(out_, frame.time);
+        writeRaw(out_, n);
+        out_.write(reinterpret_cast<const char*>(frame.values.data()), static_cast<std::streamsize>(sizeof(double) * n));
+        return;
+    }
+    for (std::int64_t i = 0; i < n; ++i)
+        out_ << frame.steps << "," << frame.time << "," << i * dx_ << "," << frame.values[i] << "\n";
+}
+
+void Exporter::writeDiagnostics(const DiagnosticsSeries &series)
+{
+    std::vector<Diagnostics> rows = series.samples();
+    if (!series.empty() && (rows.empty() || rows.back().steps != series.latest().steps))
+        rows.push_back(series.latest());
+
+    if (format_ == ExportCsv)
+    {
+        diagnostics_.precision(std::numeric_limits<double>::max_digits10);
+        diagnostics_ << "steps,t,min,max,mass,energy,variation\n";
+        for (const auto &d: rows)
+        {
+            diagnostics_ << d.steps << "," << d.time << "," << d.min << "," << d.max << ","
+                         << d.mass << "," << d.energy << "," << d.variation << "\n";
+        }
+        return;
+    }
+
+    out_.write("DIAG", 4);
+    writeRaw(out_, static_cast<std::int64_t>(rows.size()));
+    for (const auto &d: rows)
+        writeRaw(out_, d.steps);
+    for (auto column: {&Diagnostics::time, &Diagnostics::min, &Diagnostics::max, &Diagnostics::mass,
+                       &Diagnostics::energy, &Diagnostics::variation})
+    {
+        for (const auto &d: rows)
+            writeRaw(out_, d.*column);
+    }
+}
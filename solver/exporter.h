@@ -0,0 +1,95 @@
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "solver.h"
+
+// Binary export: the magic "TEEXPORT", a uint32 length and that many bytes
+// of "key value" lines (nx, nt, dx, dt, alpha, method, profile), then
+// blocks tagged by four characters, all numbers little-endian:
+//   "SNAP" int64 steps, float64 time, int64 n, n float64 values of u
+//   "DIAG" int64 rows, then the columns steps (int64), t, min, max, mass,
+//          energy and variation (float64), rows values each
+//   "END "
+// CSV export: the same metadata as '#' lines, "steps,t,x,u" rows for the
+// snapshots, and the diagnostics in a second file next to it.
+enum ExportFormat {ExportBinary, ExportCsv};
+
+const char* exportFormatName(ExportFormat format);
+bool exportFormatFromName(const std::string &name, ExportFormat *format);
+// "run.csv" -> "run_diagnostics.csv", anything else gets ".diagnostics.csv".
+std::string diagnosticsPath(const std::string &path);
+
+// Snapshots in flight between the time loop and the writer thread.
+constexpr std::size_t kExportQueue = 4;
+// Snapshots an export keeps by default.
+constexpr std::int64_t kExportSnapshots = 100;
+std::int64_t exportStride(std::int64_t nt);
+
+// Writes snapshots of a run on a background thread. append() copies the
+// state into one of kExportQueue buffers and returns; the formatting and
+// the I/O happen on the writer thread. If every buffer is in flight the
+// snapshot is dropped, unless the exporter was opened to wait.
+class Exporter
+{
+public:
+    Exporter();
+    ~Exporter();
+
+    Exporter(const Exporter&) = delete;
+    Exporter& operator=(const Exporter&) = delete;
+
+    bool open(const std::string &path, ExportFormat format, const Solver &solver, std::int64_t stride,
+              bool wait = false);
+    bool isOpen() const;
+
+    std::int64_t stride() const;
+    std::int64_t nextStep(std::int64_t steps) const;
+
+    // Queues the state of the solver if its step is a multiple of the
+    // stride, or anyway if force is set.
+    void append(const Solver &solver, bool force = false);
+    // Drains the queue, writes the diagnostics and closes the files. False
+    // if anything failed to be written.
+    bool finish(const DiagnosticsSeries &series);
+
+    std::int64_t written() const;
+    std::int64_t dropped() const;
+
+private:
+    struct Frame
+    {
+        std::int64_t steps;
+        double time;
+        std::vector<double> values;
+    };
+
+    ExportFormat format_;
+    std::ofstream out_, diagnostics_;
+    std::int64_t stride_, last_;
+    double dx_;
+    bool wait_;
+
+    std::thread writer_;
+    std::mutex mutex_;
+    std::condition_variable queued_, freed_;
+    std::deque<Frame> queue_;
+    std::vector<std::vector<double>> free_;
+    bool closing_, failed_;
+    std::int64_t written_, dropped_;
+
+    void work();
+    void writeFrame(const Frame &frame);
+    void writeDiagnostics(const DiagnosticsSeries &series);
+};
+
+#endif // EXPORTER_H
@@ -0,0 +1,96 @@
+#include "field.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+constexpr std::size_t kAlignment = 64 / sizeof(double);
+
+Field::Field(std::size_t size)
+    : data_(nullptr), size_(0)
+{
+    allocate(size);
+}
+
+Field::Field(const std::vector<double> &values)
+    : data_(nullptr), size_(0)
+{
+    allocate(values.size());
+    std::copy(values.begin(), values.end(), data_);
+    fillGhosts();
+}
+
+Field::Field(const Field &other)
+    : data_(nullptr), size_(0)
+{
+    allocate(other.size_);
+    std::copy(other.data_ - kGhost, other.data_ + size_ + kGhost, data_ - kGhost);
+}
+
+Field& Field::operator=(const Field &other)
+{
+    if (this != &other)
+    {
+        Field copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+void Field::allocate(std::size_t size)
+{
+    size_ = size;
+    storage_.assign(size + 2*kGhost + kAlignment, 0.0);
+    auto misalignment = (reinterpret_cast<std::uintptr_t>(storage_.data()) / sizeof(double)) % kAlignment;
+    data_ = storage_.data() + (kAlignment - misalignment) % kAlignment + kGhost;
+}
+
+std::size_t Field::size() const
+{
+    return size_;
+}
+
+double* Field::data()
+{
+    return data_;
+}
+
+const double* Field::data() const
+{
+    return data_;
+}
+
+const double* Field::begin() const
+{
+    return data_;
+}
+
+const double* Field::end() const
+{
+    return data_ + size_;
+}
+
+double& Field::operator[](std::size_t i)
+{
+    return data_[i];
+}
+
+double Field::operator[](std::size_t i) const
+{
+    return data_[i];
+}
+
+void Field::fillGhosts()
+{
+    if (size_ == 0)
+        return;
+    std::fill(data_ - kGhost, data_, data_[0]);
+    std::fill(data_ + size_, data_ + size_ + kGhost, data_[size_-1]);
+}
+
+void Field::swap(Field &other)
+{
+    storage_.swap(other.storage_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+}
@@ -0,0 +1,44 @@
+#ifndef FIELD_H
+#define FIELD_H
+
+#include <cstddef>
+#include <vector>
+
+constexpr std::size_t kGhost = 8;
+
+// Grid function with kGhost padding cells on either side, so that vector
+// kernels can read neighbours without bounds checks. The first real cell
+// is aligned to 64 bytes, which starts every run of eight cells from it on
+// a cache line. The kernels still use unaligned loads and stores: their
+// neighbour reads sit one cell off, and sweeps start at cell 1.
+class Field
+{
+public:
+    explicit Field(std::size_t size = 0);
+    explicit Field(const std::vector<double> &values);
+    Field(const Field &other);
+    Field& operator=(const Field &other);
+
+    std::size_t size() const;
+
+    double* data();
+    const double* data() const;
+    const double* begin() const;
+    const double* end() const;
+
+    double& operator[](std::size_t i);
+    double operator[](std::size_t i) const;
+
+    // Copies the edge values into the ghost cells.
+    void fillGhosts();
+    void swap(Field &other);
+
+private:
+    std::vector<double> storage_;
+    double *data_;
+    std::size_t size_;
+
+    void allocate(std::size_t size);
+};
+
+#endif // FIELD_H
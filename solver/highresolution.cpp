@@ -0,0 +1,88 @@
+#include "highresolution.h"
+
+#include "kernels.h"
+#include "trace.h"
+
+// The upwind flux through the right face of cell j for the harmonic
+// u_j = exp(-i j kappa) is face * u_j; the one through its left face that
+// times exp(i kappa).
+std::complex<double> highResolutionAmplification(double kappa, double alpha, MethodType type)
+{
+    const std::complex<double> left = std::polar(1.0, kappa);
+    const std::complex<double> right = std::polar(1.0, -kappa);
+    std::complex<double> face;
+    if (type == Weno5)
+        face = (2.0*left*left - 13.0*left + 47.0 + 27.0*right - 3.0*right*right) / 60.0;
+    else
+        face = 1.0 + 0.25 * (right - left);
+
+    const std::complex<double> z = -alpha * face * (1.0 - left);
+    if (type == Weno5)
+        return 1.0 + z + z*z / 2.0 + z*z*z / 6.0;
+    return 1.0 + z + z*z / 2.0;
+}
+
+HighResolutionScheme::HighResolutionScheme(std::size_t n, double alpha, MethodType method, bool periodic)
+    : n_(n), alpha_(alpha), method_(method), periodic_(periodic), stage_(n), faces_(n)
+{
+}
+
+void HighResolutionScheme::step(Field &in, Field &out)
+{
+    TRACE_SCOPE("HighResolutionScheme::step");
+    fillGhosts(in);
+    if (method_ == Weno5)
+    {
+        stage(in, in, out, 0.0, 1.0);
+        stage(in, out, stage_, 0.75, 0.25);
+        stage(in, stage_, out, 1.0/3.0, 2.0/3.0);
+    }
+    else
+    {
+        stage(in, in, stage_, 0.0, 1.0);
+        stage(in, stage_, out, 0.5, 0.5);
+    }
+}
+
+bool HighResolutionScheme::periodic() const
+{
+    return periodic_;
+}
+
+void HighResolutionScheme::fillGhosts(Field &u) const
+{
+    if (!periodic_)
+    {
+        u.fillGhosts();
+        return;
+    }
+    // Cell n-1 is cell 0 again, so the period is n-1.
+    const std::size_t m = n_ - 1;
+    double *p = u.data();
+    for (std::size_t k = 1; k <= 3; ++k)
+    {
+        p[-static_cast<std::ptrdiff_t>(k)] = p[m - k % m];
+        p[m + k] = p[k % m];
+    }
+}
+
+void HighResolutionScheme::stage(const Field &u0, Field &v, Field &out, double a, double b)
+{
+    fillGhosts(v);
+    // faces[i] is the face to the right of cell i, faces[-1] the inflow one.
+    reconstructFaces(v.data() - 1, faces_.data() - 1, n_ + 1, method_);
+
+    const double *u = u0.data();
+    const double *w = v.data();
+    const double *f = faces_.data();
+    double *next = out.data();
+    const double c = b * alpha_;
+    const std::size_t first = periodic_ ? 0 : 1;
+    const std::size_t cells = periodic_ ? n_ - 1 : n_;
+    for (std::size_t i = first; i < cells; ++i)
+        next[i] = a * u[i] + b * w[i] - c * (f[i] - f[i-1]);
+    if (periodic_)
+        next[n_-1] = next[0];
+    else
+        next[0] = u[0];
+}
@@ -0,0 +1,44 @@
+#ifndef HIGHRESOLUTION_H
+#define HIGHRESOLUTION_H
+
+#include <complex>
+#include <cstddef>
+
+#include "field.h"
+#include "scheme.h"
+
+// Amplification factor of the high-resolution schemes linearized about a
+// smooth state: all three limiters give the centred (Fromm) slope there,
+// WENO5 its fifth-order upwind blend, each followed by its Runge-Kutta
+// stages.
+std::complex<double> highResolutionAmplification(double kappa, double alpha, MethodType type);
+
+// Finite-volume form of u_t + u_x = 0 with upwind fluxes, the face values
+// reconstructed by reconstructFaces(), and the strong-stability-preserving
+// Runge-Kutta schemes of Shu and Osher in time: two stages for MUSCL, three
+// for WENO5. Fixed boundaries hold the inflow cell and extend both ends
+// flat into the ghost cells; periodic ones wrap the ghost cells around,
+// the last cell being the image of the first.
+class HighResolutionScheme
+{
+public:
+    HighResolutionScheme(std::size_t n, double alpha, MethodType method, bool periodic);
+
+    // One step of in into out; refreshes the ghost cells of in.
+    void step(Field &in, Field &out);
+
+    bool periodic() const;
+
+private:
+    std::size_t n_;
+    double alpha_;
+    MethodType method_;
+    bool periodic_;
+    Field stage_, faces_;
+
+    void fillGhosts(Field &u) const;
+    // out = a*u0 + b*(v + dt L(v)), L the upwind flux difference.
+    void stage(const Field &u0, Field &v, Field &out, double a, double b);
+};
+
+#endif // HIGHRESOLUTION_H
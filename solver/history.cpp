@@ -0,0 +1,302 @@
+#include "history.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+const char kHistoryMagic[8] = {'T', 'E', 'H', 'I', 'S', 'T', '0', '1'};
+
+struct HistoryHeader
+{
+    char magic[8];
+    std::int64_t nx, nt, stride;
+    double dx, dt;
+    std::int64_t reserved[2];
+};
+static_assert(sizeof(HistoryHeader) == 64, "frames must start 64-byte aligned");
+
+// Bytes mapped at once, so that playback does not remap on every frame.
+constexpr std::int64_t kHistoryWindow = std::int64_t(64) << 20;
+
+std::int64_t frameBytes(std::int64_t nx)
+{
+    return static_cast<std::int64_t>(sizeof(std::int64_t) + sizeof(double) * (nx + 1));
+}
+
+}
+
+std::int64_t historyStride(std::int64_t nx, std::int64_t nt, std::int64_t max_bytes)
+{
+    double bytes = static_cast<double>(frameBytes(nx)) * (nt + 1) + sizeof(HistoryHeader);
+    return std::max<std::int64_t>(1, static_cast<std::int64_t>(std::ceil(bytes / std::max<std::int64_t>(max_bytes, 1))));
+}
+
+HistoryWriter::HistoryWriter()
+    : nx_(0), stride_(1), last_(-1)
+{
+}
+
+bool HistoryWriter::open(const std::string &path, const Parameters &param, std::int64_t stride)
+{
+    close();
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_)
+        return false;
+
+    nx_ = param.get_nx();
+    stride_ = std::max<std::int64_t>(stride, 1);
+    last_ = -1;
+
+    HistoryHeader header = {};
+    std::memcpy(header.magic, kHistoryMagic, sizeof(header.magic));
+    header.nx = nx_;
+    header.nt = param.get_nt();
+    header.stride = stride_;
+    header.dx = param.get_dx();
+    header.dt = param.get_dt();
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out_.flush();
+    return static_cast<bool>(out_);
+}
+
+void HistoryWriter::close()
+{
+    if (out_.is_open())
+        out_.close();
+    out_.clear();
+}
+
+bool HistoryWriter::isOpen() const
+{
+    return out_.is_open();
+}
+
+std::int64_t HistoryWriter::stride() const
+{
+    return stride_;
+}
+
+std::int64_t HistoryWriter::nextStep(std::int64_t steps) const
+{
+    return (steps / stride_ + 1) * stride_;
+}
+
+bool HistoryWriter::append(const Solver &solver, bool force)
+{
+    std::int64_t steps = solver.steps();
+    if (!out_.is_open() || steps == last_ || (steps % stride_ != 0 && !force))
+        return static_cast<bool>(out_);
+
+    double time = solver.time();
+    out_.write(reinterpret_cast<const char*>(&steps), sizeof(steps));
+    out_.write(reinterpret_cast<const char*>(&time), sizeof(time));
+    out_.write(reinterpret_cast<const char*>(solver.state().data()), sizeof(double) * nx_);
+    // Readers map the file while it grows; only whole frames are counted.
+    out_.flush();
+    last_ = steps;
+    return static_cast<bool>(out_);
+}
+
+HistoryReader::HistoryReader()
+    :
+#ifdef _WIN32
+      file_(INVALID_HANDLE_VALUE), mapping_(nullptr), mapping_size_(0),
+#else
+      fd_(-1),
+#endif
+      nx_(0), nt_(0), stride_(1), dx_(0.0), dt_(0.0), size_(0), granularity_(1),
+      window_(nullptr), window_begin_(0), window_end_(0)
+{
+}
+
+HistoryReader::~HistoryReader()
+{
+    close();
+}
+
+bool HistoryReader::open(const std::string &path)
+{
+    close();
+    HistoryHeader header;
+#ifdef _WIN32
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+        return false;
+    DWORD read = 0;
+    bool ok = ReadFile(file_, &header, sizeof(header), &read, nullptr) && read == sizeof(header);
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    granularity_ = info.dwAllocationGranularity;
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0)
+        return false;
+    bool ok = ::pread(fd_, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    granularity_ = ::sysconf(_SC_PAGESIZE);
+#endif
+    if (!ok || std::memcmp(header.magic, kHistoryMagic, sizeof(header.magic)) != 0 || header.nx < 1)
+    {
+        close();
+        return false;
+    }
+    nx_ = header.nx;
+    nt_ = header.nt;
+    stride_ = header.stride;
+    dx_ = header.dx;
+    dt_ = header.dt;
+    return true;
+}
+
+void HistoryReader::close()
+{
+    unmap();
+#ifdef _WIN32
+    if (mapping_)
+        CloseHandle(mapping_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    if (file_ != INVALID_HANDLE_VALUE)
+        CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+#else
+    if (fd_ >= 0)
+        ::close(fd_);
+    fd_ = -1;
+#endif
+    size_ = 0;
+}
+
+bool HistoryReader::isOpen() const
+{
+#ifdef _WIN32
+    return file_ != INVALID_HANDLE_VALUE;
+#else
+    return fd_ >= 0;
+#endif
+}
+
+std::int64_t HistoryReader::nx() const
+{
+    return nx_;
+}
+
+std::int64_t HistoryReader::nt() const
+{
+    return nt_;
+}
+
+std::int64_t HistoryReader::stride() const
+{
+    return stride_;
+}
+
+double HistoryReader::dx() const
+{
+    return dx_;
+}
+
+double HistoryReader::dt() const
+{
+    return dt_;
+}
+
+std::int64_t HistoryReader::frames()
+{
+    if (!isOpen())
+        return 0;
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size))
+        return 0;
+    size_ = size.QuadPart;
+#else
+    struct stat status;
+    if (::fstat(fd_, &status) != 0)
+        return 0;
+    size_ = status.st_size;
+#endif
+    return std::max<std::int64_t>(size_ - static_cast<std::int64_t>(sizeof(HistoryHeader)), 0) / frameBytes(nx_);
+}
+
+bool HistoryReader::frame(std::int64_t index, HistoryFrame &frame)
+{
+    std::int64_t begin = sizeof(HistoryHeader) + index * frameBytes(nx_);
+    std::int64_t end = begin + frameBytes(nx_);
+    if (index < 0 || (end > size_ && index >= frames()))
+        return false;
+
+    if (!window_ || begin < window_begin_ || end > window_end_)
+    {
+        unmap();
+        std::int64_t offset = begin / granularity_ * granularity_;
+        std::int64_t last = std::min(std::max(end, offset + kHistoryWindow), size_);
+        if (!map(offset, last - offset))
+            return false;
+    }
+
+    const char *data = window_ + (begin - window_begin_);
+    std::memcpy(&frame.steps, data, sizeof(frame.steps));
+    std::memcpy(&frame.time, data + sizeof(frame.steps), sizeof(frame.time));
+    frame.values = reinterpret_cast<const double*>(data + sizeof(frame.steps) + sizeof(frame.time));
+    return true;
+}
+
+bool HistoryReader::map(std::int64_t offset, std::int64_t length)
+{
+#ifdef _WIN32
+    // A mapping object covers the file as it was when it was created.
+    if (mapping_ && mapping_size_ < offset + length)
+    {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+    if (!mapping_)
+    {
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        mapping_size_ = size_;
+        if (!mapping_)
+            return false;
+    }
+    void *view = MapViewOfFile(mapping_, FILE_MAP_READ, static_cast<DWORD>(offset >> 32),
+                               static_cast<DWORD>(offset & 0xffffffff), static_cast<SIZE_T>(length));
+    if (!view)
+        return false;
+#else
+    void *view = ::mmap(nullptr, static_cast<std::size_t>(length), PROT_READ, MAP_SHARED, fd_, static_cast<off_t>(offset));
+    if (view == MAP_FAILED)
+        return false;
+#endif
+    window_ = static_cast<const char*>(view);
+    window_begin_ = offset;
+    window_end_ = offset + length;
+    return true;
+}
+
+void HistoryReader::unmap()
+{
+    if (!window_)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(window_);
+#else
+    ::munmap(const_cast<char*>(window_), static_cast<std::size_t>(window_end_ - window_begin_));
+#endif
+    window_ = nullptr;
+    window_begin_ = window_end_ = 0;
+}
@@ -0,0 +1,95 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "solver.h"
+
+// Time history of a run as a flat binary file: a 64-byte header, then one
+// frame per recorded step holding the step, the time and the nx values of
+// the grid. It is written sequentially and read back through a memory
+// mapping, so histories larger than RAM can be paged through frame by frame
+// without copying.
+
+// Default size limit of a history file.
+constexpr std::int64_t kHistoryBytes = std::int64_t(4) << 30;
+
+// Smallest stride between recorded steps that keeps a run of nt steps on
+// nx points within max_bytes.
+std::int64_t historyStride(std::int64_t nx, std::int64_t nt, std::int64_t max_bytes = kHistoryBytes);
+
+class HistoryWriter
+{
+public:
+    HistoryWriter();
+
+    bool open(const std::string &path, const Parameters &param, std::int64_t stride);
+    void close();
+    bool isOpen() const;
+
+    std::int64_t stride() const;
+    // The next step after steps that is to be recorded.
+    std::int64_t nextStep(std::int64_t steps) const;
+
+    // Writes the state of the solver if its step is a multiple of the
+    // stride, or anyway if force is set. False on a write error.
+    bool append(const Solver &solver, bool force = false);
+
+private:
+    std::ofstream out_;
+    std::int64_t nx_, stride_, last_;
+};
+
+struct HistoryFrame
+{
+    std::int64_t steps;
+    double time;
+    const double *values;
+};
+
+class HistoryReader
+{
+public:
+    HistoryReader();
+    ~HistoryReader();
+
+    HistoryReader(const HistoryReader&) = delete;
+    HistoryReader& operator=(const HistoryReader&) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const;
+
+    std::int64_t nx() const;
+    std::int64_t nt() const;
+    std::int64_t stride() const;
+    double dx() const;
+    double dt() const;
+
+    // Complete frames in the file; the writer may still be appending, so
+    // this looks at the file size again on every call.
+    std::int64_t frames();
+    // Maps a window of the file around the frame. The values stay valid
+    // until the next call to frame() or close().
+    bool frame(std::int64_t index, HistoryFrame &frame);
+
+private:
+#ifdef _WIN32
+    void *file_, *mapping_;
+    std::int64_t mapping_size_;
+#else
+    int fd_;
+#endif
+    std::int64_t nx_, nt_, stride_;
+    double dx_, dt_;
+    std::int64_t size_, granularity_;
+    const char *window_;
+    std::int64_t window_begin_, window_end_;
+
+    bool map(std::int64_t offset, std::int64_t length);
+    void unmap();
+};
+
+#endif // HISTORY_H
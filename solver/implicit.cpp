@@ -0,0 +1,46 @@
+#include "implicit.h"
+
+#include "trace.h"
+
+ImplicitScheme::ImplicitScheme(std::size_t n, double alpha, MethodType method, bool periodic, unsigned threads)
+    : n_(n), periodic_(periodic)
+{
+    const double theta = method == CrankNicolson ? 0.5 : 1.0;
+    implicit_ = 0.5 * theta * alpha;
+    explicit_ = 0.5 * (1.0 - theta) * alpha;
+    if (periodic_)
+        cyclic_.factor(n_ - 1, -implicit_, 1.0, implicit_, threads);
+    else
+        fixed_.factor(n_ - 2, -implicit_, 1.0, implicit_, 1.0, 1.0, threads);
+}
+
+void ImplicitScheme::step(const double *in, double *out)
+{
+    TRACE_SCOPE("ImplicitScheme::step");
+    const std::size_t n = n_;
+    if (periodic_)
+    {
+        // Cells 0 .. n-2 are the unknowns; cell n-1 is cell 0 again.
+        const std::size_t m = n - 1;
+        out[0] = in[0] - explicit_ * (in[1] - in[m-1]);
+        for (std::size_t i = 1; i < m; ++i)
+            out[i] = in[i] - explicit_ * (in[i+1] - in[i-1]);
+        cyclic_.solve(out);
+        out[m] = out[0];
+        return;
+    }
+
+    // The known boundary values move to the right-hand side.
+    out[0] = in[0];
+    out[n-1] = in[n-1];
+    for (std::size_t i = 1; i+1 < n; ++i)
+        out[i] = in[i] - explicit_ * (in[i+1] - in[i-1]);
+    out[1] += implicit_ * out[0];
+    out[n-2] -= implicit_ * out[n-1];
+    fixed_.solve(out + 1);
+}
+
+bool ImplicitScheme::periodic() const
+{
+    return periodic_;
+}
@@ -0,0 +1,36 @@
+#ifndef IMPLICIT_H
+#define IMPLICIT_H
+
+#include <cstddef>
+
+#include "scheme.h"
+#include "tridiagonal.h"
+
+// The theta scheme with the centred difference in space,
+//     x[i] + theta*alpha/2 * (x[i+1] - x[i-1])
+//         = u[i] - (1 - theta)*alpha/2 * (u[i+1] - u[i-1]),
+// theta = 1 for BackwardEuler and 1/2 for CrankNicolson. Fixed boundaries
+// keep the first and last cell and leave a plain tridiagonal system for the
+// interior; periodic ones make the last cell the image of the first and
+// the system cyclic.
+class ImplicitScheme
+{
+public:
+    // threads as for ThreadPool, 0 meaning one per core, used only for
+    // grids of at least kParallelSolveCells.
+    ImplicitScheme(std::size_t n, double alpha, MethodType method, bool periodic, unsigned threads = 1);
+
+    // One step of the n cells of in into out.
+    void step(const double *in, double *out);
+
+    bool periodic() const;
+
+private:
+    std::size_t n_;
+    bool periodic_;
+    double implicit_, explicit_;        // theta*alpha/2 and (1 - theta)*alpha/2
+    TridiagonalSolver fixed_;
+    CyclicTridiagonalSolver cyclic_;
+};
+
+#endif // IMPLICIT_H
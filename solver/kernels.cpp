@@ -0,0 +1,205 @@
+#include "kernels.h"
+
+#include "kernels_impl.h"
+
+#include <cmath>
+#include <limits>
+
+#ifdef KERNELS_X86
+void sweepAvx2(const double *in, double *out, std::size_t n, MethodType type, const Stencil &s);
+void sweepAvx512(const double *in, double *out, std::size_t n, MethodType type, const Stencil &s);
+void sweepReduceAvx2(const double *in, double *out, std::size_t begin, std::size_t end,
+                     MethodType type, const Stencil &s, Reduction &r);
+void sweepReduceAvx512(const double *in, double *out, std::size_t begin, std::size_t end,
+                       MethodType type, const Stencil &s, Reduction &r);
+void ensembleSweepAvx2(const double *in, double *out, std::size_t cells, std::size_t members,
+                       const double *left, const double *centre, const double *right);
+void ensembleSweepAvx512(const double *in, double *out, std::size_t cells, std::size_t members,
+                         const double *left, const double *centre, const double *right);
+void reconstructFacesAvx2(const double *u, double *face, std::size_t n, MethodType type);
+void reconstructFacesAvx512(const double *u, double *face, std::size_t n, MethodType type);
+#endif
+
+Stencil stencil(MethodType type, double alpha)
+{
+    switch (type)
+    {
+    case Upwind:
+        return Scheme<Upwind>::coefficients(alpha);
+    case Lax:
+        return Scheme<Lax>::coefficients(alpha);
+    case LaxWendroff:
+        return Scheme<LaxWendroff>::coefficients(alpha);
+    default:
+        break;
+    }
+    return Stencil{0.0, 1.0, 0.0};
+}
+
+KernelIsa detectedKernelIsa()
+{
+#ifdef KERNELS_X86
+    static const KernelIsa isa = __builtin_cpu_supports("avx512f") ? IsaAvx512
+                               : (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ? IsaAvx2
+                               : IsaScalar;
+    return isa;
+#else
+    return IsaScalar;
+#endif
+}
+
+static KernelIsa& selectedIsa()
+{
+    static KernelIsa isa = detectedKernelIsa();
+    return isa;
+}
+
+KernelIsa kernelIsa()
+{
+    return selectedIsa();
+}
+
+void setKernelIsa(KernelIsa isa)
+{
+    selectedIsa() = isa < detectedKernelIsa() ? isa : detectedKernelIsa();
+}
+
+const char* kernelIsaName(KernelIsa isa)
+{
+    switch (isa)
+    {
+    case IsaAvx2:
+        return "avx2";
+    case IsaAvx512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+void sweep(const double *in, double *out, std::size_t n, MethodType type, const Stencil &s)
+{
+#ifdef KERNELS_X86
+    switch (kernelIsa())
+    {
+    case IsaAvx512:
+        sweepAvx512(in, out, n, type, s);
+        return;
+    case IsaAvx2:
+        sweepAvx2(in, out, n, type, s);
+        return;
+    default:
+        break;
+    }
+#endif
+
+    switch (type)
+    {
+    case Upwind:
+        sweepKernel<Scheme<Upwind>, ScalarOps>(in, out, n, s);
+        break;
+    case Lax:
+        sweepKernel<Scheme<Lax>, ScalarOps>(in, out, n, s);
+        break;
+    case LaxWendroff:
+        sweepKernel<Scheme<LaxWendroff>, ScalarOps>(in, out, n, s);
+        break;
+    default:
+        break;
+    }
+}
+
+Reduction emptyReduction()
+{
+    return Reduction{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 0.0, 0.0, 0.0};
+}
+
+void accumulate(Reduction &r, double u, double previous)
+{
+    r.min = std::min(r.min, u);
+    r.max = std::max(r.max, u);
+    r.sum += u;
+    r.sum_squares += u*u;
+    r.variation += std::abs(u - previous);
+}
+
+void merge(Reduction &r, const Reduction &other)
+{
+    r.min = std::min(r.min, other.min);
+    r.max = std::max(r.max, other.max);
+    r.sum += other.sum;
+    r.sum_squares += other.sum_squares;
+    r.variation += other.variation;
+}
+
+void sweepReduce(const double *in, double *out, std::size_t begin, std::size_t end,
+                 MethodType type, const Stencil &s, Reduction &r)
+{
+#ifdef KERNELS_X86
+    switch (kernelIsa())
+    {
+    case IsaAvx512:
+        sweepReduceAvx512(in, out, begin, end, type, s, r);
+        return;
+    case IsaAvx2:
+        sweepReduceAvx2(in, out, begin, end, type, s, r);
+        return;
+    default:
+        break;
+    }
+#endif
+
+    switch (type)
+    {
+    case Upwind:
+        sweepReduceKernel<Scheme<Upwind>, ScalarOps>(in, out, begin, end, s, r);
+        break;
+    case Lax:
+        sweepReduceKernel<Scheme<Lax>, ScalarOps>(in, out, begin, end, s, r);
+        break;
+    case LaxWendroff:
+        sweepReduceKernel<Scheme<LaxWendroff>, ScalarOps>(in, out, begin, end, s, r);
+        break;
+    default:
+        break;
+    }
+}
+
+void ensembleSweep(const double *in, double *out, std::size_t cells, std::size_t members,
+                   const double *left, const double *centre, const double *right)
+{
+#ifdef KERNELS_X86
+    switch (kernelIsa())
+    {
+    case IsaAvx512:
+        ensembleSweepAvx512(in, out, cells, members, left, centre, right);
+        return;
+    case IsaAvx2:
+        ensembleSweepAvx2(in, out, cells, members, left, centre, right);
+        return;
+    default:
+        break;
+    }
+#endif
+
+    ensembleKernel<ScalarOps>(in, out, cells, members, left, centre, right);
+}
+
+void reconstructFaces(const double *u, double *face, std::size_t n, MethodType type)
+{
+#ifdef KERNELS_X86
+    switch (kernelIsa())
+    {
+    case IsaAvx512:
+        reconstructFacesAvx512(u, face, n, type);
+        return;
+    case IsaAvx2:
+        reconstructFacesAvx2(u, face, n, type);
+        return;
+    default:
+        break;
+    }
+#endif
+
+    reconstructFaces<ScalarOps>(u, face, n, type);
+}
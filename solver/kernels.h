@@ -0,0 +1,101 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstddef>
+
+#include "scheme.h"
+
+// Explicit AVX2/AVX-512 kernels are built with GCC target pragmas.
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_X86
+#endif
+
+// All three explicit schemes are three-point linear stencils:
+//     next[i] = left*u[i-1] + centre*u[i] + right*u[i+1]
+struct Stencil
+{
+    double left, centre, right;
+};
+
+// Compile-time description of each scheme: which taps are non-zero and how
+// the coefficients follow from the CFL number.
+template <MethodType Method>
+struct Scheme;
+
+template <>
+struct Scheme<Upwind>
+{
+    static constexpr bool kLeft = true, kCentre = true, kRight = false;
+    static Stencil coefficients(double alpha)
+    {
+        return Stencil{alpha, 1.0 - alpha, 0.0};
+    }
+};
+
+template <>
+struct Scheme<Lax>
+{
+    static constexpr bool kLeft = true, kCentre = false, kRight = true;
+    static Stencil coefficients(double alpha)
+    {
+        return Stencil{0.5*(1.0 + alpha), 0.0, 0.5*(1.0 - alpha)};
+    }
+};
+
+template <>
+struct Scheme<LaxWendroff>
+{
+    static constexpr bool kLeft = true, kCentre = true, kRight = true;
+    static Stencil coefficients(double alpha)
+    {
+        return Stencil{0.5*alpha*(1.0 + alpha), 1.0 - alpha*alpha, 0.5*alpha*(alpha - 1.0)};
+    }
+};
+
+Stencil stencil(MethodType type, double alpha);
+
+enum KernelIsa {IsaScalar, IsaAvx2, IsaAvx512};
+
+// The widest instruction set supported by both the build and the CPU.
+KernelIsa detectedKernelIsa();
+KernelIsa kernelIsa();
+// Restricts the kernels to a narrower instruction set (for comparisons);
+// requests beyond detectedKernelIsa() are clamped.
+void setKernelIsa(KernelIsa isa);
+const char* kernelIsaName(KernelIsa isa);
+
+// Applies the stencil to cells [0, n) of in, writing out. in[-1] and in[n]
+// must be readable (ghost cells).
+void sweep(const double *in, double *out, std::size_t n, MethodType type, const Stencil &s);
+
+// Running reduction over grid values: extremes, sum of u and of u^2, and
+// total variation, the sum of |u[i] - u[i-1]|.
+struct Reduction
+{
+    double min, max, sum, sum_squares, variation;
+};
+
+Reduction emptyReduction();
+// Adds a cell with value u whose left neighbour holds previous.
+void accumulate(Reduction &r, double u, double previous);
+void merge(Reduction &r, const Reduction &other);
+
+// Applies the stencil to cells [begin, end) and folds the new values into r
+// in the same pass. The variation of the first cell is taken against
+// out[begin-1], which must already hold its new value.
+void sweepReduce(const double *in, double *out, std::size_t begin, std::size_t end,
+                 MethodType type, const Stencil &s, Reduction &r);
+
+// Ensemble layout: cell i of member m is at in[i*members + m], and each
+// member has its own coefficients. Updates cells [1, cells-1) of every
+// member; members must be a multiple of kEnsembleAlignment.
+constexpr std::size_t kEnsembleAlignment = 8;
+void ensembleSweep(const double *in, double *out, std::size_t cells, std::size_t members,
+                   const double *left, const double *centre, const double *right);
+
+// The high-resolution schemes reconstruct, for cells [0, n), the value at
+// the right face of each from the upwind side: face[i] = u(x[i] + dx/2)
+// from u[i-2] .. u[i+2], which must be readable (ghost cells).
+void reconstructFaces(const double *u, double *face, std::size_t n, MethodType type);
+
+#endif // KERNELS_H
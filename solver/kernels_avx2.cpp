@@ -0,0 +1,103 @@
+#include "kernels.h"
+
+#ifdef KERNELS_X86
+
+#include <immintrin.h>
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+#include "kernels_impl.h"
+
+namespace {
+
+struct Avx2Ops
+{
+    typedef __m256d Vector;
+    static constexpr std::size_t kWidth = 4;
+    static Vector set1(double x) { return _mm256_set1_pd(x); }
+    static Vector loadu(const double *p) { return _mm256_loadu_pd(p); }
+    static void storeu(double *p, Vector v) { _mm256_storeu_pd(p, v); }
+    static Vector mul(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+    static Vector div(Vector a, Vector b) { return _mm256_div_pd(a, b); }
+    static Vector fmadd(Vector a, Vector b, Vector c) { return _mm256_fmadd_pd(a, b, c); }
+    static Vector add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+    static Vector sub(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+    static Vector min(Vector a, Vector b) { return _mm256_min_pd(a, b); }
+    static Vector max(Vector a, Vector b) { return _mm256_max_pd(a, b); }
+    static Vector abs(Vector a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    // {last[3], cur[0], cur[1], cur[2]}
+    static Vector previous(Vector last, Vector cur)
+    {
+        return _mm256_shuffle_pd(_mm256_permute2f128_pd(last, cur, 0x21), cur, 0x5);
+    }
+    static double reduceAdd(Vector v)
+    {
+        __m128d half = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+    static double reduceMin(Vector v)
+    {
+        __m128d half = _mm_min_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_min_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+    static double reduceMax(Vector v)
+    {
+        __m128d half = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_max_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+};
+
+}
+
+void sweepAvx2(const double *in, double *out, std::size_t n, MethodType type, const Stencil &s)
+{
+    switch (type)
+    {
+    case Upwind:
+        sweepKernel<Scheme<Upwind>, Avx2Ops>(in, out, n, s);
+        break;
+    case Lax:
+        sweepKernel<Scheme<Lax>, Avx2Ops>(in, out, n, s);
+        break;
+    case LaxWendroff:
+        sweepKernel<Scheme<LaxWendroff>, Avx2Ops>(in, out, n, s);
+        break;
+    default:
+        break;
+    }
+}
+
+void sweepReduceAvx2(const double *in, double *out, std::size_t begin, std::size_t end,
+                     MethodType type, const Stencil &s, Reduction &r)
+{
+    switch (type)
+    {
+    case Upwind:
+        sweepReduceKernel<Scheme<Upwind>, Avx2Ops>(in, out, begin, end, s, r);
+        break;
+    case Lax:
+        sweepReduceKernel<Scheme<Lax>, Avx2Ops>(in, out, begin, end, s, r);
+        break;
+    case LaxWendroff:
+        sweepReduceKernel<Scheme<LaxWendroff>, Avx2Ops>(in, out, begin, end, s, r);
+        break;
+    default:
+        break;
+    }
+}
+
+void ensembleSweepAvx2(const double *in, double *out, std::size_t cells, std::size_t members,
+                       const double *left, const double *centre, const double *right)
+{
+    ensembleKernel<Avx2Ops>(in, out, cells, members, left, centre, right);
+}
+
+void reconstructFacesAvx2(const double *u, double *face, std::size_t n, MethodType type)
+{
+    reconstructFaces<Avx2Ops>(u, face, n, type);
+}
+
+#pragma GCC pop_options
+
+#endif
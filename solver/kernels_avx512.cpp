@@ -0,0 +1,97 @@
+#include "kernels.h"
+
+#ifdef KERNELS_X86
+
+// GCC 12 flags the _mm512_undefined_pd() pass-through inside its own
+// intrinsics as maybe-uninitialized.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include <immintrin.h>
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+#include "kernels_impl.h"
+
+namespace {
+
+struct Avx512Ops
+{
+    typedef __m512d Vector;
+    static constexpr std::size_t kWidth = 8;
+    static Vector set1(double x) { return _mm512_set1_pd(x); }
+    static Vector loadu(const double *p) { return _mm512_loadu_pd(p); }
+    static void storeu(double *p, Vector v) { _mm512_storeu_pd(p, v); }
+    static Vector mul(Vector a, Vector b) { return _mm512_mul_pd(a, b); }
+    static Vector div(Vector a, Vector b) { return _mm512_div_pd(a, b); }
+    static Vector fmadd(Vector a, Vector b, Vector c) { return _mm512_fmadd_pd(a, b, c); }
+    static Vector add(Vector a, Vector b) { return _mm512_add_pd(a, b); }
+    static Vector sub(Vector a, Vector b) { return _mm512_sub_pd(a, b); }
+    static Vector min(Vector a, Vector b) { return _mm512_min_pd(a, b); }
+    static Vector max(Vector a, Vector b) { return _mm512_max_pd(a, b); }
+    static Vector abs(Vector a) { return _mm512_abs_pd(a); }
+    // {last[7], cur[0], ..., cur[6]}
+    static Vector previous(Vector last, Vector cur)
+    {
+        return _mm512_permutex2var_pd(cur, _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 15), last);
+    }
+    static double reduceAdd(Vector v) { return _mm512_reduce_add_pd(v); }
+    static double reduceMin(Vector v) { return _mm512_reduce_min_pd(v); }
+    static double reduceMax(Vector v) { return _mm512_reduce_max_pd(v); }
+};
+
+}
+
+void sweepAvx512(const double *in, double *out, std::size_t n, MethodType type, const Stencil &s)
+{
+    switch (type)
+    {
+    case Upwind:
+        sweepKernel<Scheme<Upwind>, Avx512Ops>(in, out, n, s);
+        break;
+    case Lax:
+        sweepKernel<Scheme<Lax>, Avx512Ops>(in, out, n, s);
+        break;
+    case LaxWendroff:
+        sweepKernel<Scheme<LaxWendroff>, Avx512Ops>(in, out, n, s);
+        break;
+    default:
+        break;
+    }
+}
+
+void sweepReduceAvx512(const double *in, double *out, std::size_t begin, std::size_t end,
+                       MethodType type, const Stencil &s, Reduction &r)
+{
+    switch (type)
+    {
+    case Upwind:
+        sweepReduceKernel<Scheme<Upwind>, Avx512Ops>(in, out, begin, end, s, r);
+        break;
+    case Lax:
+        sweepReduceKernel<Scheme<Lax>, Avx512Ops>(in, out, begin, end, s, r);
+        break;
+    case LaxWendroff:
+        sweepReduceKernel<Scheme<LaxWendroff>, Avx512Ops>(in, out, begin, end, s, r);
+        break;
+    default:
+        break;
+    }
+}
+
+void ensembleSweepAvx512(const double *in, double *out, std::size_t cells, std::size_t members,
+                         const double *left, const double *centre, const double *right)
+{
+    ensembleKernel<Avx512Ops>(in, out, cells, members, left, centre, right);
+}
+
+void reconstructFacesAvx512(const double *u, double *face, std::size_t n, MethodType type)
+{
+    reconstructFaces<Avx512Ops>(u, face, n, type);
+}
+
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
+
+#endif
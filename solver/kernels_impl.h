@@ -0,0 +1,252 @@
+#ifndef KERNELS_IMPL_H
+#define KERNELS_IMPL_H
+
+// Generic stencil sweep, instantiated once per instruction set. Ops supplies
+// the vector type and its load/store/arithmetic; this header is included by
+// each kernels*.cpp after the target options for that set are enabled.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "kernels.h"
+
+namespace {
+
+// One lane: the portable kernels and the tails of the vector ones.
+struct ScalarOps
+{
+    typedef double Vector;
+    static constexpr std::size_t kWidth = 1;
+    static Vector set1(double x) { return x; }
+    static Vector loadu(const double *p) { return *p; }
+    static void storeu(double *p, Vector v) { *p = v; }
+    static Vector mul(Vector a, Vector b) { return a*b; }
+    static Vector div(Vector a, Vector b) { return a/b; }
+    static Vector fmadd(Vector a, Vector b, Vector c) { return a*b + c; }
+    static Vector add(Vector a, Vector b) { return a + b; }
+    static Vector sub(Vector a, Vector b) { return a - b; }
+    static Vector min(Vector a, Vector b) { return std::min(a, b); }
+    static Vector max(Vector a, Vector b) { return std::max(a, b); }
+    static Vector abs(Vector a) { return std::abs(a); }
+    static Vector previous(Vector last, Vector) { return last; }
+    static double reduceAdd(Vector v) { return v; }
+    static double reduceMin(Vector v) { return v; }
+    static double reduceMax(Vector v) { return v; }
+};
+
+}
+
+template <class S, class Ops>
+inline typename Ops::Vector applyStencil(const double *u, typename Ops::Vector l, typename Ops::Vector c,
+                                         typename Ops::Vector r)
+{
+    typename Ops::Vector acc = Ops::set1(0.0);
+    if (S::kLeft)
+        acc = Ops::fmadd(l, Ops::loadu(u - 1), acc);
+    if (S::kCentre)
+        acc = Ops::fmadd(c, Ops::loadu(u), acc);
+    if (S::kRight)
+        acc = Ops::fmadd(r, Ops::loadu(u + 1), acc);
+    return acc;
+}
+
+template <class S>
+inline double applyStencil(const double *u, const Stencil &s)
+{
+    double acc = 0.0;
+    if (S::kLeft)
+        acc += s.left * u[-1];
+    if (S::kCentre)
+        acc += s.centre * u[0];
+    if (S::kRight)
+        acc += s.right * u[1];
+    return acc;
+}
+
+template <class S, class Ops>
+void sweepKernel(const double *in, double *out, std::size_t n, const Stencil &s)
+{
+    typedef typename Ops::Vector V;
+    const V l = Ops::set1(s.left);
+    const V c = Ops::set1(s.centre);
+    const V r = Ops::set1(s.right);
+
+    std::size_t i = 0;
+    for (; i + Ops::kWidth <= n; i += Ops::kWidth)
+        Ops::storeu(out + i, applyStencil<S, Ops>(in + i, l, c, r));
+    for (; i < n; ++i)
+        out[i] = applyStencil<S>(in + i, s);
+}
+
+// sweepKernel with the Reduction kept in registers: the variation needs the
+// previous new value, which is the last vector shifted in by one lane.
+template <class S, class Ops>
+void sweepReduceKernel(const double *in, double *out, std::size_t begin, std::size_t end,
+                       const Stencil &s, Reduction &red)
+{
+    typedef typename Ops::Vector V;
+    const V l = Ops::set1(s.left);
+    const V c = Ops::set1(s.centre);
+    const V r = Ops::set1(s.right);
+
+    V lo = Ops::set1(red.min), hi = Ops::set1(red.max);
+    V sum = Ops::set1(0.0), squares = Ops::set1(0.0), variation = Ops::set1(0.0);
+    V last = Ops::set1(out[begin-1]);
+
+    std::size_t i = begin;
+    for (; i + Ops::kWidth <= end; i += Ops::kWidth)
+    {
+        V acc = applyStencil<S, Ops>(in + i, l, c, r);
+        Ops::storeu(out + i, acc);
+        lo = Ops::min(lo, acc);
+        hi = Ops::max(hi, acc);
+        sum = Ops::add(sum, acc);
+        squares = Ops::fmadd(acc, acc, squares);
+        variation = Ops::add(variation, Ops::abs(Ops::sub(acc, Ops::previous(last, acc))));
+        last = acc;
+    }
+    red.min = std::min(red.min, Ops::reduceMin(lo));
+    red.max = std::max(red.max, Ops::reduceMax(hi));
+    red.sum += Ops::reduceAdd(sum);
+    red.sum_squares += Ops::reduceAdd(squares);
+    red.variation += Ops::reduceAdd(variation);
+
+    for (; i < end; ++i)
+    {
+        out[i] = applyStencil<S>(in + i, s);
+        accumulate(red, out[i], out[i-1]);
+    }
+}
+
+template <class Ops>
+void ensembleKernel(const double *in, double *out, std::size_t cells, std::size_t members,
+                    const double *left, const double *centre, const double *right)
+{
+    typedef typename Ops::Vector V;
+    for (std::size_t i = 1; i + 1 < cells; ++i)
+    {
+        const double *u = in + i*members;
+        double *next = out + i*members;
+        for (std::size_t m = 0; m < members; m += Ops::kWidth)
+        {
+            V acc = Ops::mul(Ops::loadu(left + m), Ops::loadu(u - members + m));
+            acc = Ops::fmadd(Ops::loadu(centre + m), Ops::loadu(u + m), acc);
+            acc = Ops::fmadd(Ops::loadu(right + m), Ops::loadu(u + members + m), acc);
+            Ops::storeu(next + m, acc);
+        }
+    }
+}
+
+// minmod(a, b): the smaller in magnitude if both have the same sign, else 0.
+template <class Ops>
+inline typename Ops::Vector minmod(typename Ops::Vector a, typename Ops::Vector b)
+{
+    const typename Ops::Vector zero = Ops::set1(0.0);
+    return Ops::add(Ops::max(Ops::min(a, b), zero), Ops::min(Ops::max(a, b), zero));
+}
+
+// MUSCL slope of a cell from its backward difference a and forward
+// difference b, without branches so that it vectorizes.
+template <MethodType Method, class Ops>
+inline typename Ops::Vector limitedSlope(typename Ops::Vector a, typename Ops::Vector b)
+{
+    typedef typename Ops::Vector V;
+    if (Method == MusclSuperbee)
+    {
+        // x and y share the sign of a and b, so the larger is x + y - minmod.
+        const V two = Ops::set1(2.0);
+        V x = minmod<Ops>(a, Ops::mul(two, b));
+        V y = minmod<Ops>(Ops::mul(two, a), b);
+        return Ops::sub(Ops::add(x, y), minmod<Ops>(x, y));
+    }
+    if (Method == MusclVanLeer)
+    {
+        // Harmonic mean (a|b| + |a|b) / (|a| + |b|); zero if the signs differ.
+        V abs_a = Ops::abs(a), abs_b = Ops::abs(b);
+        V denominator = Ops::add(Ops::add(abs_a, abs_b), Ops::set1(std::numeric_limits<double>::min()));
+        return Ops::div(Ops::fmadd(a, abs_b, Ops::mul(abs_a, b)), denominator);
+    }
+    return minmod<Ops>(a, b);
+}
+
+// Value at the right face of the cell at u, reconstructed from the upwind
+// side: the cell value plus half the limited slope, or the WENO5 blend of
+// the three third-order candidates weighted by their smoothness.
+template <MethodType Method, class Ops>
+inline typename Ops::Vector reconstructFace(const double *u)
+{
+    typedef typename Ops::Vector V;
+    if (Method != Weno5)
+    {
+        V c = Ops::loadu(u);
+        V slope = limitedSlope<Method, Ops>(Ops::sub(c, Ops::loadu(u - 1)), Ops::sub(Ops::loadu(u + 1), c));
+        return Ops::fmadd(Ops::set1(0.5), slope, c);
+    }
+
+    const V v1 = Ops::loadu(u - 2), v2 = Ops::loadu(u - 1), v3 = Ops::loadu(u);
+    const V v4 = Ops::loadu(u + 1), v5 = Ops::loadu(u + 2);
+    const V two = Ops::set1(2.0), three = Ops::set1(3.0), four = Ops::set1(4.0);
+    const V c13 = Ops::set1(13.0 / 12.0), quarter = Ops::set1(0.25);
+
+    // Smoothness indicators.
+    V d0 = Ops::add(Ops::sub(v1, Ops::mul(two, v2)), v3);
+    V e0 = Ops::add(Ops::sub(v1, Ops::mul(four, v2)), Ops::mul(three, v3));
+    V d1 = Ops::add(Ops::sub(v2, Ops::mul(two, v3)), v4);
+    V e1 = Ops::sub(v2, v4);
+    V d2 = Ops::add(Ops::sub(v3, Ops::mul(two, v4)), v5);
+    V e2 = Ops::add(Ops::sub(Ops::mul(three, v3), Ops::mul(four, v4)), v5);
+    V b0 = Ops::fmadd(c13, Ops::mul(d0, d0), Ops::mul(quarter, Ops::mul(e0, e0)));
+    V b1 = Ops::fmadd(c13, Ops::mul(d1, d1), Ops::mul(quarter, Ops::mul(e1, e1)));
+    V b2 = Ops::fmadd(c13, Ops::mul(d2, d2), Ops::mul(quarter, Ops::mul(e2, e2)));
+
+    // Weights d_k / (eps + b_k)^2 with the linear weights 1/10, 6/10, 3/10.
+    const V eps = Ops::set1(1e-6);
+    b0 = Ops::add(b0, eps);
+    b1 = Ops::add(b1, eps);
+    b2 = Ops::add(b2, eps);
+    V w0 = Ops::div(Ops::set1(0.1), Ops::mul(b0, b0));
+    V w1 = Ops::div(Ops::set1(0.6), Ops::mul(b1, b1));
+    V w2 = Ops::div(Ops::set1(0.3), Ops::mul(b2, b2));
+
+    // Candidates (2v1 - 7v2 + 11v3)/6, (-v2 + 5v3 + 2v4)/6, (2v3 + 5v4 - v5)/6.
+    V q0 = Ops::fmadd(Ops::set1(11.0), v3, Ops::fmadd(Ops::set1(-7.0), v2, Ops::mul(two, v1)));
+    V q1 = Ops::fmadd(two, v4, Ops::fmadd(Ops::set1(5.0), v3, Ops::sub(Ops::set1(0.0), v2)));
+    V q2 = Ops::sub(Ops::fmadd(Ops::set1(5.0), v4, Ops::mul(two, v3)), v5);
+    V sum = Ops::fmadd(w0, q0, Ops::fmadd(w1, q1, Ops::mul(w2, q2)));
+    return Ops::div(sum, Ops::mul(Ops::set1(6.0), Ops::add(w0, Ops::add(w1, w2))));
+}
+
+template <MethodType Method, class Ops>
+void reconstructKernel(const double *u, double *face, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + Ops::kWidth <= n; i += Ops::kWidth)
+        Ops::storeu(face + i, reconstructFace<Method, Ops>(u + i));
+    for (; i < n; ++i)
+        face[i] = reconstructFace<Method, ScalarOps>(u + i);
+}
+
+template <class Ops>
+void reconstructFaces(const double *u, double *face, std::size_t n, MethodType type)
+{
+    switch (type)
+    {
+    case MusclMinmod:
+        reconstructKernel<MusclMinmod, Ops>(u, face, n);
+        break;
+    case MusclSuperbee:
+        reconstructKernel<MusclSuperbee, Ops>(u, face, n);
+        break;
+    case MusclVanLeer:
+        reconstructKernel<MusclVanLeer, Ops>(u, face, n);
+        break;
+    case Weno5:
+        reconstructKernel<Weno5, Ops>(u, face, n);
+        break;
+    default:
+        break;
+    }
+}
+
+#endif // KERNELS_IMPL_H
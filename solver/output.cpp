@@ -0,0 +1,61 @@
+#include "output.h"
+
+#include <limits>
+#include <vector>
+
+void writeSolution(std::ostream &out, const Solver &solver, std::size_t stride)
+{
+    const Parameters &param = solver.parameters();
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "# profile " << profileName(solver.profile())
+        << " method " << methodName(solver.method())
+        << " nx " << param.get_nx() << " nt " << param.get_nt()
+        << " dx " << param.get_dx() << " dt " << param.get_dt()
+        << " alpha " << param.get_alpha()
+        << " steps " << solver.steps() << " t " << solver.time()
+        << (solver.diverged() ? " diverged" : "") << "\n";
+    out << "# x initial solution\n";
+
+    const Field &state = solver.state();
+    for (std::size_t i = 0; i < state.size(); i += stride)
+    {
+        double x = i * param.get_dx();
+        out << x << " " << initial(x, solver.profile()) << " " << state[i] << "\n";
+    }
+}
+
+void writeAmrSolution(std::ostream &out, const AmrSolver &solver, std::size_t stride)
+{
+    const Parameters &param = solver.parameters();
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "# profile " << profileName(solver.profile())
+        << " method " << methodName(solver.method())
+        << " nx " << param.get_nx() << " nt " << param.get_nt()
+        << " dx " << param.get_dx() << " dt " << param.get_dt()
+        << " alpha " << param.get_alpha()
+        << " levels " << solver.levels() << " cells " << solver.cells()
+        << " steps " << solver.steps() << " t " << solver.time()
+        << (solver.diverged() ? " diverged" : "") << "\n";
+    out << "# x initial solution\n";
+
+    std::vector<double> x, u, width;
+    solver.composite(x, u, width);
+    for (std::size_t i = 0; i < x.size(); i += stride)
+        out << x[i] << " " << initial(x[i], solver.profile()) << " " << u[i] << "\n";
+}
+
+static void writeSample(std::ostream &out, const Diagnostics &d)
+{
+    out << d.steps << " " << d.time << " " << d.min << " " << d.max << " "
+        << d.mass << " " << d.energy << " " << d.variation << "\n";
+}
+
+void writeDiagnostics(std::ostream &out, const DiagnosticsSeries &series)
+{
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "# steps t min max mass energy variation\n";
+    for (const auto &d: series.samples())
+        writeSample(out, d);
+    if (!series.empty() && (series.samples().empty() || series.samples().back().steps != series.latest().steps))
+        writeSample(out, series.latest());
+}
@@ -0,0 +1,21 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <cstddef>
+#include <ostream>
+
+#include "amr.h"
+#include "solver.h"
+
+// Writes every stride-th cell of the run as whitespace-separated columns
+// "x initial solution", preceded by a '#' header with the run parameters.
+void writeSolution(std::ostream &out, const Solver &solver, std::size_t stride = 1);
+// The same for the composite grid of an adaptive run, x being the centre of
+// each leaf cell; the header gives the base grid and the levels.
+void writeAmrSolution(std::ostream &out, const AmrSolver &solver, std::size_t stride = 1);
+
+// Writes the diagnostics time series, one "steps t min max mass energy
+// variation" row per kept sample and a final one for the latest state.
+void writeDiagnostics(std::ostream &out, const DiagnosticsSeries &series);
+
+#endif // OUTPUT_H
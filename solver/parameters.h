@@ -0,0 +1,36 @@
+#ifndef PARAMETERS_H
+#define PARAMETERS_H
+
+#include <cstdint>
+#include <string>
+
+constexpr double kRangeX = 10.0;
+constexpr double kRangeT = 5.0;
+
+class Parameters
+{
+public:
+    Parameters(std::int64_t nx, std::int64_t nt, double range_x, double range_t);
+
+    std::int64_t get_nx() const;
+    std::int64_t get_nt() const;
+    double get_dx() const;
+    double get_dt() const;
+    double get_alpha() const;
+
+    void set_nx(std::int64_t nx);
+    void set_nt(std::int64_t nt);
+    void set_range_x(double range_x);
+    void set_range_t(double range_t);
+
+    std::string toString() const;
+
+private:
+    std::int64_t nx_, nt_;
+    double range_x_, range_t_;
+    double alpha_;
+
+    void set_alpha();
+};
+
+#endif // PARAMETERS_H
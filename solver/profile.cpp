@@ -0,0 +1,64 @@
+#include "profile.h"
+
+#include <cmath>
+
+double initial(double x, InitialProfile profile)
+{
+    switch (profile)
+    {
+    case Gauss:
+        return std::exp(-std::pow(x - kRangeX/4.0, 2.0));
+    case SuperGauss:
+        return std::exp(-std::pow(x - kRangeX/4.0, 8.0));
+    case Rectangle:
+        return (x > kRangeX/8.0 && x < kRangeX * 3.0 / 8.0) ? 1.0 : 0.0;
+    case Step:
+        return (x < kRangeX/4.0) ? 0.0 : 1.0;
+    default:
+        return 0;
+    }
+}
+
+std::vector<double> initialState(const Parameters &param, InitialProfile profile)
+{
+    std::vector<double> state(static_cast<std::size_t>(param.get_nx()));
+    fillInitialState(param, profile, state.data());
+    return state;
+}
+
+void fillInitialState(const Parameters &param, InitialProfile profile, double *state)
+{
+    const double dx = param.get_dx();
+    const std::int64_t nx = param.get_nx();
+    for (std::int64_t i = 0; i < nx; ++i)
+        state[i] = initial(i * dx, profile);
+}
+
+static const char* const kProfileNames[] = {"gauss", "supergauss", "rectangle", "step"};
+static_assert(sizeof(kProfileNames) / sizeof(kProfileNames[0]) == kProfileCount, "a name for every profile");
+
+const char* profileName(InitialProfile profile)
+{
+    return kProfileNames[profile];
+}
+
+bool profileFromName(const std::string &name, InitialProfile *profile)
+{
+    for (int i = 0; i < kProfileCount; ++i)
+    {
+        if (name == kProfileNames[i])
+        {
+            *profile = static_cast<InitialProfile>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<InitialProfile> allProfiles()
+{
+    std::vector<InitialProfile> profiles;
+    for (int i = 0; i < kProfileCount; ++i)
+        profiles.push_back(static_cast<InitialProfile>(i));
+    return profiles;
+}
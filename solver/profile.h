@@ -0,0 +1,21 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <string>
+#include <vector>
+
+#include "parameters.h"
+
+enum InitialProfile {Gauss, SuperGauss, Rectangle, Step};
+constexpr int kProfileCount = 4;
+
+double initial(double x, InitialProfile profile);
+std::vector<double> initialState(const Parameters &param, InitialProfile profile);
+void fillInitialState(const Parameters &param, InitialProfile profile, double *state);
+
+const char* profileName(InitialProfile profile);
+bool profileFromName(const std::string &name, InitialProfile *profile);
+// Every profile, in enum order.
+std::vector<InitialProfile> allProfiles();
+
+#endif // PROFILE_H
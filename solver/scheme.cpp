@@ -0,0 +1,117 @@
+#include "scheme.h"
+
+#include <cmath>
+#include <complex>
+
+#include "highresolution.h"
+#include "semilagrangian.h"
+
+std::pair<double, double> dispersion_diffusion(double q_N, double alpha, MethodType type)
+{
+    std::complex<double> lambda;
+    double kappa = 2.0*M_PI*q_N;
+    switch (type)
+    {
+    case Upwind:
+        lambda = 1.0 - alpha * (1.0 - std::exp(std::complex<double>(0.0, kappa)));
+        break;
+    case Lax:
+        lambda = std::complex<double>(std::cos(kappa), alpha * std::sin(kappa));
+        break;
+    case LaxWendroff:
+        lambda = std::complex<double>(1.0 - alpha*alpha * (1.0 - std::cos(kappa)), alpha * std::sin(kappa));
+        break;
+    case Spectral:
+        // Exact phase shift of every resolved harmonic.
+        return std::make_pair(alpha * kappa, 0.0);
+    case BackwardEuler:
+        lambda = 1.0 / std::complex<double>(1.0, -alpha * std::sin(kappa));
+        break;
+    case CrankNicolson:
+        lambda = std::complex<double>(1.0, 0.5*alpha * std::sin(kappa)) /
+                 std::complex<double>(1.0, -0.5*alpha * std::sin(kappa));
+        break;
+    case SemiLagrangianLinear:
+    case SemiLagrangianCubic:
+    case SemiLagrangianMonotone:
+    {
+        // The whole cells p shift the phase exactly, so it is kept out of
+        // the logarithm rather than wrapped; the clipped cubic counts as
+        // the cubic, which it is away from extrema.
+        double w[4];
+        double p = semiLagrangianWeights(alpha, type, w);
+        std::complex<double> sum = w[0] * std::polar(1.0, 2.0*kappa) + w[1] * std::polar(1.0, kappa)
+                                 + w[2] + w[3] * std::polar(1.0, -kappa);
+        return std::make_pair(p * kappa + std::arg(sum), -std::log(std::abs(sum)));
+    }
+    case MusclMinmod:
+    case MusclSuperbee:
+    case MusclVanLeer:
+    case Weno5:
+        lambda = highResolutionAmplification(kappa, alpha, type);
+        break;
+    default:
+        lambda = 1.0;
+        break;
+    }
+
+    lambda = std::log(lambda);
+
+    return std::make_pair(std::imag(lambda), -std::real(lambda));
+}
+
+bool isStencilMethod(MethodType type)
+{
+    return type == Upwind || type == Lax || type == LaxWendroff;
+}
+
+bool isImplicitMethod(MethodType type)
+{
+    return type == BackwardEuler || type == CrankNicolson;
+}
+
+bool isSemiLagrangianMethod(MethodType type)
+{
+    return type == SemiLagrangianLinear || type == SemiLagrangianCubic || type == SemiLagrangianMonotone;
+}
+
+bool isHighResolutionMethod(MethodType type)
+{
+    return type == MusclMinmod || type == MusclSuperbee || type == MusclVanLeer || type == Weno5;
+}
+
+bool isLinearMethod(MethodType type)
+{
+    return type != SemiLagrangianMonotone && !isHighResolutionMethod(type);
+}
+
+static const char* const kMethodNames[] = {"upwind", "lax", "lax-wendroff", "spectral", "backward-euler", "crank-nicolson",
+                                           "semi-lagrangian-linear", "semi-lagrangian-cubic", "semi-lagrangian-monotone",
+                                           "muscl-minmod", "muscl-superbee", "muscl-van-leer", "weno5"};
+static_assert(sizeof(kMethodNames) / sizeof(kMethodNames[0]) == kMethodCount, "a name for every method");
+
+const char* methodName(MethodType type)
+{
+    return kMethodNames[type];
+}
+
+bool methodFromName(const std::string &name, MethodType *type)
+{
+    for (int i = 0; i < kMethodCount; ++i)
+    {
+        if (name == kMethodNames[i])
+        {
+            *type = static_cast<MethodType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<MethodType> allMethods()
+{
+    std::vector<MethodType> methods;
+    for (int i = 0; i < kMethodCount; ++i)
+        methods.push_back(static_cast<MethodType>(i));
+    return methods;
+}
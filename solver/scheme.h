@@ -0,0 +1,42 @@
+#ifndef SCHEME_H
+#define SCHEME_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+enum MethodType {Upwind, Lax, LaxWendroff, Spectral, BackwardEuler, CrankNicolson,
+                 SemiLagrangianLinear, SemiLagrangianCubic, SemiLagrangianMonotone,
+                 MusclMinmod, MusclSuperbee, MusclVanLeer, Weno5};
+constexpr int kMethodCount = 13;
+
+// Upwind, Lax and LaxWendroff are three-point stencils with fixed boundary
+// values; Spectral is a Fourier pseudo-spectral method on a periodic grid.
+bool isStencilMethod(MethodType type);
+// BackwardEuler and CrankNicolson take the centred difference at the new
+// time level and solve a tridiagonal system each step; both are stable for
+// any CFL number.
+bool isImplicitMethod(MethodType type);
+// The semi-Lagrangian schemes interpolate the state at the foot of the
+// characteristic, linearly, with a cubic or with a cubic clipped to the
+// neighbouring values; stable for any CFL number.
+bool isSemiLagrangianMethod(MethodType type);
+// The high-resolution schemes reconstruct face values with a limited slope
+// (MUSCL with the minmod, superbee or van Leer limiter, SSP-RK2 in time) or
+// by WENO5 (SSP-RK3 in time): sharp fronts without oscillations.
+bool isHighResolutionMethod(MethodType type);
+// Every scheme but the clipped cubic and the high-resolution ones is
+// linear, so that a step multiplies each harmonic by its amplification
+// factor.
+bool isLinearMethod(MethodType type);
+
+// Phase (first) and amplitude (second) error per step for the harmonic with
+// wavenumber q_N in units of the Nyquist wavenumber.
+std::pair<double, double> dispersion_diffusion(double q_N, double alpha, MethodType type);
+
+const char* methodName(MethodType type);
+bool methodFromName(const std::string &name, MethodType *type);
+// Every method, in enum order.
+std::vector<MethodType> allMethods();
+
+#endif // SCHEME_H
@@ -0,0 +1,104 @@
+#include "semilagrangian.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "trace.h"
+
+double semiLagrangianWeights(double alpha, MethodType method, double weights[4])
+{
+    const double whole = std::floor(alpha);
+    const double f = alpha - whole;
+    if (method == SemiLagrangianLinear)
+    {
+        weights[0] = 0.0;
+        weights[1] = f;
+        weights[2] = 1.0 - f;
+        weights[3] = 0.0;
+        return whole;
+    }
+
+    // Lagrange weights at t = -f of the nodes t = -2, -1, 0, 1.
+    const double t = -f;
+    weights[0] = -(t + 1.0) * t * (t - 1.0) / 6.0;
+    weights[1] = (t + 2.0) * t * (t - 1.0) / 2.0;
+    weights[2] = -(t + 2.0) * (t + 1.0) * (t - 1.0) / 2.0;
+    weights[3] = (t + 2.0) * (t + 1.0) * t / 6.0;
+    return whole;
+}
+
+SemiLagrangianScheme::SemiLagrangianScheme(std::size_t n, double alpha, MethodType method, bool periodic)
+    : n_(n), method_(method), periodic_(periodic)
+{
+    shift_ = static_cast<std::size_t>(semiLagrangianWeights(alpha, method_, weights_));
+    if (periodic_)
+        shift_ %= n_ - 1;
+}
+
+void SemiLagrangianScheme::step(const double *in, double *out) const
+{
+    TRACE_SCOPE("SemiLagrangianScheme::step");
+    // Periodic: cells 0 .. n-2, cell n-1 being cell 0 again. Fixed: the
+    // inflow cell 0 keeps its value.
+    const std::size_t cells = periodic_ ? n_ - 1 : n_;
+    const std::size_t first = periodic_ ? 0 : 1;
+    const std::size_t p = shift_;
+
+    // Cells whose four taps i-p-2 .. i-p+1 all lie in [0, n-1].
+    const std::size_t begin = std::min(std::max(first, p + 2), cells);
+    const std::size_t end = std::max(begin, std::min(cells, n_ - 1 + p));
+
+    if (!periodic_)
+        out[0] = in[0];
+    for (std::size_t i = first; i < begin; ++i)
+        out[i] = interpolate(in, i);
+
+    const double w0 = weights_[0], w1 = weights_[1], w2 = weights_[2], w3 = weights_[3];
+    switch (method_)
+    {
+    case SemiLagrangianLinear:
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = w1 * in[i-p-1] + w2 * in[i-p];
+        break;
+    case SemiLagrangianCubic:
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = w0 * in[i-p-2] + w1 * in[i-p-1] + w2 * in[i-p] + w3 * in[i-p+1];
+        break;
+    default:
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const double b = in[i-p-1], c = in[i-p];
+            double u = w0 * in[i-p-2] + w1 * b + w2 * c + w3 * in[i-p+1];
+            out[i] = std::min(std::max(u, std::min(b, c)), std::max(b, c));
+        }
+        break;
+    }
+
+    for (std::size_t i = end; i < cells; ++i)
+        out[i] = interpolate(in, i);
+    if (periodic_)
+        out[n_-1] = out[0];
+}
+
+bool SemiLagrangianScheme::periodic() const
+{
+    return periodic_;
+}
+
+double SemiLagrangianScheme::interpolate(const double *in, std::size_t i) const
+{
+    const std::ptrdiff_t k = static_cast<std::ptrdiff_t>(i) - static_cast<std::ptrdiff_t>(shift_);
+    const double a = value(in, k-2), b = value(in, k-1), c = value(in, k), d = value(in, k+1);
+    double u = weights_[0] * a + weights_[1] * b + weights_[2] * c + weights_[3] * d;
+    if (method_ == SemiLagrangianMonotone)
+        u = std::min(std::max(u, std::min(b, c)), std::max(b, c));
+    return u;
+}
+
+double SemiLagrangianScheme::value(const double *in, std::ptrdiff_t k) const
+{
+    const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(n_);
+    if (periodic_)
+        return in[((k % (n-1)) + (n-1)) % (n-1)];
+    return in[std::min(std::max<std::ptrdiff_t>(k, 0), n-1)];
+}
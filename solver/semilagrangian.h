@@ -0,0 +1,46 @@
+#ifndef SEMILAGRANGIAN_H
+#define SEMILAGRANGIAN_H
+
+#include <cstddef>
+
+#include "scheme.h"
+
+// Traces the characteristic through each cell back by alpha cells and
+// interpolates the old state there: linearly between the two cells around
+// the departure point, with the cubic through the four nearest ones, or
+// with that cubic clipped to the two around it so that no new extrema
+// appear. Stable for any CFL number.
+//
+// The velocity is constant, so every departure point lies the same whole
+// number of cells p and fraction f back; the gather is then a shifted
+// contiguous load and the interpolation a fixed four-point stencil, which
+// the compiler vectorizes. Only cells whose taps leave the grid take the
+// scalar path: with fixed boundaries the inflow value holds to the left and
+// the last cell to the right; periodic ones wrap around.
+// Splits alpha into the whole cells p, which it returns, and the fraction
+// f, and gives the weights of cells i-p-2, i-p-1, i-p and i-p+1 at the
+// departure point i - alpha.
+double semiLagrangianWeights(double alpha, MethodType method, double weights[4]);
+
+class SemiLagrangianScheme
+{
+public:
+    SemiLagrangianScheme(std::size_t n, double alpha, MethodType method, bool periodic);
+
+    // One step of the n cells of in into out.
+    void step(const double *in, double *out) const;
+
+    bool periodic() const;
+
+private:
+    std::size_t n_;
+    MethodType method_;
+    bool periodic_;
+    std::size_t shift_;                 // p, modulo the period if periodic
+    double weights_[4];                 // of cells i-p-2, i-p-1, i-p and i-p+1
+
+    double interpolate(const double *in, std::size_t i) const;
+    double value(const double *in, std::ptrdiff_t k) const;
+};
+
+#endif // SEMILAGRANGIAN_H
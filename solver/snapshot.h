@@ -0,0 +1,21 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "diagnostics.h"
+#include "view.h"
+
+struct Snapshot
+{
+    // Min/max envelope of the grid over at most kViewPoints columns.
+    Envelope view;
+    std::int64_t steps = 0;
+    double time = 0.0;
+    bool diverged = false;
+    // The diagnostics time series so far, reduced to a few hundred samples.
+    std::vector<Diagnostics> diagnostics;
+};
+
+#endif // SNAPSHOT_H
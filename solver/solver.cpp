@@ -0,0 +1,484 @@
+#include "solver.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "trace.h"
+
+Solver::Solver(const Parameters &param, InitialProfile profile, MethodType method)
+    : param_(param), profile_(profile), method_(method), stencil_(stencil(method, param.get_alpha())),
+      state_(static_cast<std::size_t>(param.get_nx())), tmp_state_(), steps_(0),
+      blocking_(true), tile_width_(kTileWidth), tile_steps_(kTileSteps), periodic_(false), origin_steps_(0),
+      tracking_(false), tolerance_(kActiveTolerance), threshold_(0.0),
+      active_begin_(0), active_end_(0), stale_begin_(0), stale_end_(0), blocked_steps_(0),
+      threads_(1), decomposition_current_(false), state_behind_(false)
+{
+    fillInitialState(param_, profile_, state_.data());
+    state_.fillGhosts();
+    tmp_state_ = state_;
+
+    record(reduce(state_.data(), state_.size()));
+
+    if (isImplicitMethod(method_))
+        implicit_.reset(new ImplicitScheme(state_.size(), param_.get_alpha(), method_, false, threads_));
+    if (isSemiLagrangianMethod(method_))
+        semi_lagrangian_.reset(new SemiLagrangianScheme(state_.size(), param_.get_alpha(), method_, false));
+    if (isHighResolutionMethod(method_))
+        high_resolution_.reset(new HighResolutionScheme(state_.size(), param_.get_alpha(), method_, false));
+    if (method_ == Spectral)
+        setFourierPropagation(true);
+    setActiveRegion(true);
+}
+
+void Solver::step()
+{
+    leaveDecomposition();
+    if (spectral_)
+    {
+        advance(1);
+        return;
+    }
+
+    auto n = state_.size();
+    if (implicit_ || semi_lagrangian_ || high_resolution_)
+    {
+        if (implicit_)
+            implicit_->step(state_.data(), tmp_state_.data());
+        else if (semi_lagrangian_)
+            semi_lagrangian_->step(state_.data(), tmp_state_.data());
+        else
+            high_resolution_->step(state_, tmp_state_);
+        state_.swap(tmp_state_);
+        ++steps_;
+        record(reduce(state_.data(), n));
+        return;
+    }
+    if (useTracking())
+    {
+        trackedStep();
+        return;
+    }
+
+    // Boundary values stay fixed, so the ghost cells filled once from them
+    // remain valid; only the interior is swept. A periodic boundary cell
+    // takes its left neighbour from the other end.
+    Reduction r = emptyReduction();
+    if (periodic_)
+        tmp_state_[0] = stencil_.left * state_[n-2] + stencil_.centre * state_[0] + stencil_.right * state_[1];
+    else
+        tmp_state_[0] = state_[0];
+    accumulate(r, tmp_state_[0], tmp_state_[0]);
+    sweepReduce(state_.data(), tmp_state_.data(), 1, n-1, method_, stencil_, r);
+    tmp_state_[n-1] = periodic_ ? tmp_state_[0] : state_[n-1];
+    accumulate(r, tmp_state_[n-1], tmp_state_[n-2]);
+    state_.swap(tmp_state_);
+    ++steps_;
+    record(r);
+}
+
+void Solver::advance(std::int64_t steps)
+{
+    TRACE_SCOPE("Solver::advance");
+    steps = std::min(steps, param_.get_nt() - steps_);
+    if (spectral_)
+    {
+        if (steps <= 0)
+            return;
+        leaveDecomposition();
+        spectral_->jump(state_.data(), steps_ + steps - origin_steps_);
+        steps_ += steps;
+        record(reduce(state_.data(), state_.size()));
+        return;
+    }
+    // Between tiles or threaded runs an occasional tracked step finds the
+    // active region again; once it is small, the steps go one at a time
+    // over it.
+    while (steps > 0)
+    {
+        const bool refresh = useTracking() && blocked_steps_ >= refreshSteps();
+        if (!refresh && useDecomposition())
+        {
+            std::int64_t chunk = useTracking() ? std::min(steps, refreshSteps() - blocked_steps_) : steps;
+            advanceDecomposed(chunk);
+            steps -= chunk;
+            continue;
+        }
+        if (steps == 1 || refresh || !useBlocking())
+        {
+            step();
+            --steps;
+            continue;
+        }
+        leaveDecomposition();
+        std::int64_t block = std::min<std::int64_t>(steps, tile_steps_);
+        blockedSweep(state_, tmp_state_, method_, stencil_, block, tile_width_, scratch_, tmp_scratch_, &reductions_);
+        state_.swap(tmp_state_);
+        for (const auto &r: reductions_)
+        {
+            ++steps_;
+            record(r);
+        }
+        steps -= block;
+        if (useTracking())
+        {
+            // Every chunk may have changed, and tmp_state_ lags everywhere.
+            blocked_steps_ += block;
+            active_begin_ = stale_begin_ = 0;
+            active_end_ = stale_end_ = chunks_.size();
+        }
+    }
+}
+
+void Solver::run()
+{
+    // With temporal blocking or threads the blow-up check runs once per
+    // chunk of steps; Fourier propagation jumps straight to the end.
+    std::int64_t chunk = spectral_ ? param_.get_nt() : useDecomposition() ? kDecompositionSteps
+                       : useBlocking() ? tile_steps_ : 1;
+    while (!finished() && !diverged())
+        advance(chunk);
+}
+
+void Solver::setTemporalBlocking(bool enabled, std::size_t tile_width, int tile_steps)
+{
+    blocking_ = enabled;
+    tile_width_ = std::max<std::size_t>(tile_width, 1);
+    tile_steps_ = std::max(tile_steps, 1);
+}
+
+bool Solver::temporalBlocking() const
+{
+    return blocking_;
+}
+
+void Solver::setFourierPropagation(bool enabled)
+{
+    if (!enabled)
+    {
+        if (method_ == Spectral || !spectral_)
+            return;
+        // Back to the stencil: the fixed boundary values may have moved.
+        spectral_.reset();
+        state_.fillGhosts();
+        tmp_state_ = state_;
+        refreshActiveRegion();
+        return;
+    }
+    if (!isLinearMethod(method_))
+        return;
+    leaveDecomposition();
+    if (!spectral_)
+        spectral_.reset(new SpectralPropagator(state_.size(), param_.get_alpha(), method_));
+    setOrigin();
+}
+
+bool Solver::fourierPropagation() const
+{
+    return spectral_ != nullptr;
+}
+
+void Solver::setPeriodicBoundaries(bool enabled)
+{
+    if (enabled == periodic_)
+        return;
+    leaveDecomposition();
+    periodic_ = enabled;
+    auto n = state_.size();
+    if (periodic_)
+        state_[n-1] = state_[0];
+    if (implicit_)
+        implicit_.reset(new ImplicitScheme(n, param_.get_alpha(), method_, periodic_, threads_));
+    if (semi_lagrangian_)
+        semi_lagrangian_.reset(new SemiLagrangianScheme(n, param_.get_alpha(), method_, periodic_));
+    if (high_resolution_)
+        high_resolution_.reset(new HighResolutionScheme(n, param_.get_alpha(), method_, periodic_));
+    state_.fillGhosts();
+    tmp_state_ = state_;
+    refreshActiveRegion();
+}
+
+bool Solver::periodicBoundaries() const
+{
+    return periodic_ || spectral_ != nullptr;
+}
+
+void Solver::setActiveRegion(bool enabled, double tolerance)
+{
+    synchronize();
+    tracking_ = enabled;
+    tolerance_ = std::max(tolerance, 0.0);
+    refreshActiveRegion();
+}
+
+bool Solver::activeRegion() const
+{
+    return tracking_;
+}
+
+void Solver::setThreads(unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads == threads_)
+        return;
+    leaveDecomposition();
+    threads_ = threads;
+    decomposition_.reset();
+    if (implicit_)
+        implicit_.reset(new ImplicitScheme(state_.size(), param_.get_alpha(), method_, periodic_, threads_));
+}
+
+unsigned Solver::threads() const
+{
+    return threads_;
+}
+
+std::size_t Solver::activeCells() const
+{
+    if (!useTracking())
+        return state_.size();
+    if (active_begin_ >= active_end_)
+        return 0;
+    return std::min(active_end_ * kActiveChunk, state_.size()) - active_begin_ * kActiveChunk;
+}
+
+void Solver::setOrigin()
+{
+    spectral_->setOrigin(state_.data());
+    origin_steps_ = steps_;
+    origin_diagnostics_ = diagnostics_.latest();
+}
+
+bool Solver::jumpTo(std::int64_t steps)
+{
+    if (!spectral_)
+        return false;
+    leaveDecomposition();
+    steps = std::max(std::min(steps, param_.get_nt()), origin_steps_);
+    if (steps >= steps_)
+    {
+        advance(steps - steps_);
+        return true;
+    }
+
+    spectral_->jump(state_.data(), steps - origin_steps_);
+    steps_ = steps;
+    diagnostics_.clear();
+    diagnostics_.add(origin_diagnostics_);
+    if (steps_ > origin_steps_)
+        record(reduce(state_.data(), state_.size()));
+    return true;
+}
+
+bool Solver::useBlocking() const
+{
+    return blocking_ && isStencilMethod(method_) && !periodic_ && state_.size() > tile_width_ &&
+           (!useTracking() || 2 * activeCells() >= state_.size());
+}
+
+bool Solver::useTracking() const
+{
+    return tracking_ && isStencilMethod(method_) && !periodic_ && !spectral_;
+}
+
+bool Solver::decomposable() const
+{
+    return threads_ > 1 && isStencilMethod(method_) && !spectral_ && state_.size() >= kDecomposeCells;
+}
+
+// As with blocking, a small active region is faster swept serially.
+bool Solver::useDecomposition() const
+{
+    return decomposable() && (!useTracking() || 2 * activeCells() >= state_.size());
+}
+
+std::int64_t Solver::refreshSteps() const
+{
+    return kActiveRefreshSteps * (decomposable() ? threads_ : 1);
+}
+
+void Solver::advanceDecomposed(std::int64_t steps)
+{
+    if (!decomposition_ || decomposition_->periodic() != periodic_)
+    {
+        synchronize();
+        decomposition_.reset(new DomainDecomposition(state_.size(), method_, stencil_, periodic_, threads_));
+        decomposition_current_ = false;
+    }
+    if (!decomposition_current_)
+    {
+        decomposition_->load(state_.data());
+        decomposition_current_ = true;
+    }
+    decomposition_->advance(steps, reductions_);
+    state_behind_ = true;
+    for (const auto &r: reductions_)
+    {
+        ++steps_;
+        record(r);
+    }
+    if (useTracking())
+    {
+        // As after a tile: every chunk counts as active and stale.
+        blocked_steps_ += steps;
+        active_begin_ = stale_begin_ = 0;
+        active_end_ = stale_end_ = chunks_.size();
+    }
+}
+
+void Solver::synchronize() const
+{
+    if (!state_behind_)
+        return;
+    decomposition_->store(state_.data());
+    state_behind_ = false;
+}
+
+void Solver::leaveDecomposition()
+{
+    synchronize();
+    decomposition_current_ = false;
+}
+
+// The step over the active chunks only. Cells it does not write must hold
+// their current values in tmp_state_ too, so the chunks swept last time
+// and not this time are copied over first.
+void Solver::trackedStep()
+{
+    const std::size_t n = state_.size();
+    auto sync = [this, n](std::size_t begin, std::size_t end) {
+        if (begin < end)
+            std::copy(state_.data() + begin * kActiveChunk, state_.data() + std::min(end * kActiveChunk, n),
+                      tmp_state_.data() + begin * kActiveChunk);
+    };
+    sync(stale_begin_, std::min(stale_end_, active_begin_));
+    sync(std::max(stale_begin_, active_end_), stale_end_);
+
+    for (std::size_t c = active_begin_; c < active_end_; ++c)
+    {
+        std::size_t begin = c * kActiveChunk;
+        const std::size_t end = std::min(begin + kActiveChunk, n);
+        Reduction r = emptyReduction();
+        if (begin == 0)
+        {
+            tmp_state_[0] = state_[0];
+            accumulate(r, tmp_state_[0], tmp_state_[0]);
+            begin = 1;
+        }
+        const std::size_t last = end == n ? n-1 : end;
+        if (begin < last)
+            sweepReduce(state_.data(), tmp_state_.data(), begin, last, method_, stencil_, r);
+        if (end == n)
+        {
+            tmp_state_[n-1] = state_[n-1];
+            accumulate(r, tmp_state_[n-1], tmp_state_[n-2]);
+        }
+        chunks_[c] = r;
+    }
+    stale_begin_ = active_begin_;
+    stale_end_ = active_end_;
+    blocked_steps_ = 0;
+    state_.swap(tmp_state_);
+    ++steps_;
+
+    Reduction total = emptyReduction();
+    for (const auto &r: chunks_)
+        merge(total, r);
+    record(total);
+    updateActiveRange();
+}
+
+// One pass over the whole state, after anything that changed it other than
+// a tracked step; tmp_state_ may lag it everywhere.
+void Solver::refreshActiveRegion()
+{
+    const std::size_t n = state_.size();
+    const double *u = state_.data();
+    chunks_.resize((n + kActiveChunk - 1) / kActiveChunk);
+    Reduction total = emptyReduction();
+    for (std::size_t c = 0; c < chunks_.size(); ++c)
+    {
+        Reduction r = emptyReduction();
+        for (std::size_t i = c * kActiveChunk; i < std::min((c+1) * kActiveChunk, n); ++i)
+            accumulate(r, u[i], i > 0 ? u[i-1] : u[i]);
+        chunks_[c] = r;
+        merge(total, r);
+    }
+    threshold_ = n > 0 ? tolerance_ * (total.max - total.min) : 0.0;
+    stale_begin_ = 0;
+    stale_end_ = chunks_.size();
+    updateActiveRange();
+}
+
+// Chunks above the threshold and one on either side; a chunk that is not
+// finite counts as active.
+void Solver::updateActiveRange()
+{
+    std::size_t first = chunks_.size(), last = 0;
+    for (std::size_t c = 0; c < chunks_.size(); ++c)
+    {
+        if (!(chunks_[c].variation <= threshold_))
+        {
+            first = std::min(first, c);
+            last = c + 1;
+        }
+    }
+    if (first >= last)
+    {
+        active_begin_ = active_end_ = 0;
+        return;
+    }
+    active_begin_ = first > 0 ? first - 1 : 0;
+    active_end_ = std::min(last + 1, chunks_.size());
+}
+
+bool Solver::finished() const
+{
+    return steps_ >= param_.get_nt();
+}
+
+bool Solver::diverged() const
+{
+    return blownUp(diagnostics_.latest());
+}
+
+const Parameters& Solver::parameters() const
+{
+    return param_;
+}
+
+InitialProfile Solver::profile() const
+{
+    return profile_;
+}
+
+MethodType Solver::method() const
+{
+    return method_;
+}
+
+std::int64_t Solver::steps() const
+{
+    return steps_;
+}
+
+double Solver::time() const
+{
+    return steps_ * param_.get_dt();
+}
+
+const Field& Solver::state() const
+{
+    synchronize();
+    return state_;
+}
+
+const DiagnosticsSeries& Solver::diagnostics() const
+{
+    return diagnostics_;
+}
+
+void Solver::record(const Reduction &r)
+{
+    diagnostics_.add(summarize(r, param_.get_dx(), steps_, time()));
+}
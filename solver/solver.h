@@ -0,0 +1,146 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <memory>
+
+#include "blocking.h"
+#include "decomposition.h"
+#include "diagnostics.h"
+#include "field.h"
+#include "highresolution.h"
+#include "implicit.h"
+#include "kernels.h"
+#include "parameters.h"
+#include "profile.h"
+#include "scheme.h"
+#include "semilagrangian.h"
+#include "spectral.h"
+
+// Active-region tracking sweeps the grid in chunks of kActiveChunk cells
+// and skips those whose variation, taken against the cell before too, is
+// at most kActiveTolerance times the range max - min of the state.
+constexpr std::size_t kActiveChunk = 1024;
+constexpr double kActiveTolerance = 1e-12;
+// Under temporal blocking, every chunk counts as active; one step in this
+// many is a tracked one instead, which finds the region again. With
+// threads, the serial tracked step comes once in this many times the
+// thread count.
+constexpr std::int64_t kActiveRefreshSteps = 4 * kTileSteps;
+
+class Solver
+{
+public:
+    Solver(const Parameters &param, InitialProfile profile, MethodType method);
+
+    void step();
+    // Up to steps steps at once, time-tiled if temporal blocking is on.
+    void advance(std::int64_t steps);
+    void run();
+
+    // Temporal blocking is used for grids wider than one tile; turning it
+    // off gives the plain one-pass-per-step sweep for comparison.
+    void setTemporalBlocking(bool enabled, std::size_t tile_width = kTileWidth, int tile_steps = kTileSteps);
+    bool temporalBlocking() const;
+
+    // Propagates the stencil schemes exactly in Fourier space from the
+    // current state on, with periodic instead of fixed boundaries: any
+    // number of steps then costs O(N log N). Always on for the spectral
+    // method; not available for the schemes that are not linear.
+    void setFourierPropagation(bool enabled);
+    bool fourierPropagation() const;
+    // Periodic instead of fixed boundaries, the last cell being the image
+    // of the first; it takes the value of the first when turned on. Steps
+    // one pass at a time, without temporal blocking. Fourier propagation
+    // and the spectral method are periodic either way.
+    void setPeriodicBoundaries(bool enabled);
+    bool periodicBoundaries() const;
+    // Updates only the chunks of the stencil schemes with fixed boundaries
+    // that are not quiescent, and their neighbours, as the stencil reaches
+    // one cell further each step; the others keep their values and their
+    // share of the diagnostics, which may lag a full sweep by the
+    // tolerance. Temporal blocking, which sweeps the whole grid, takes over
+    // while the active chunks cover at least half of it. On by default.
+    void setActiveRegion(bool enabled, double tolerance = kActiveTolerance);
+    bool activeRegion() const;
+    // Cells the next step updates.
+    std::size_t activeCells() const;
+    // Splits advance() of the stencil schemes over threads for grids of at
+    // least kDecomposeCells (see DomainDecomposition), with either
+    // boundary; threads as for ThreadPool, 0 meaning one per core, and
+    // nothing changes unless that comes to more than one. Takes the place
+    // of temporal blocking, and of active-region tracking while the active
+    // chunks cover at least half the grid. The threads then hold the state
+    // between calls, and state() gathers it. BackwardEuler and
+    // CrankNicolson use the threads for the parallel solve on grids of at
+    // least kParallelSolveCells. One thread by default.
+    void setThreads(unsigned threads);
+    // Resolved: one per core for 0.
+    unsigned threads() const;
+    // Moves straight to the given step, backwards too, with one inverse
+    // transform. Needs Fourier propagation; returns false without it.
+    // Going back restarts the diagnostics from the origin.
+    bool jumpTo(std::int64_t steps);
+
+    bool finished() const;
+    // From the diagnostics of the current state; no extra pass over the grid.
+    bool diverged() const;
+
+    const Parameters& parameters() const;
+    InitialProfile profile() const;
+    MethodType method() const;
+    std::int64_t steps() const;
+    double time() const;
+    const Field& state() const;
+    // One sample per step, filled in by the stencil pass itself.
+    const DiagnosticsSeries& diagnostics() const;
+
+private:
+    Parameters param_;
+    InitialProfile profile_;
+    MethodType method_;
+    Stencil stencil_;
+    mutable Field state_;                       // behind the decomposition while state_behind_
+    Field tmp_state_;
+    std::int64_t steps_;
+    bool blocking_;
+    std::size_t tile_width_;
+    int tile_steps_;
+    Field scratch_, tmp_scratch_;
+    std::unique_ptr<SpectralPropagator> spectral_;
+    std::unique_ptr<ImplicitScheme> implicit_;
+    std::unique_ptr<SemiLagrangianScheme> semi_lagrangian_;
+    std::unique_ptr<HighResolutionScheme> high_resolution_;
+    bool periodic_;
+    std::int64_t origin_steps_;
+    Diagnostics origin_diagnostics_;
+    DiagnosticsSeries diagnostics_;
+    std::vector<Reduction> reductions_;
+    bool tracking_;
+    double tolerance_, threshold_;
+    std::vector<Reduction> chunks_;             // of the current state, one per chunk
+    std::size_t active_begin_, active_end_;     // chunks the next step sweeps
+    std::size_t stale_begin_, stale_end_;       // chunks where tmp_state_ lags state_
+    std::int64_t blocked_steps_;                // since the last tracked step
+    unsigned threads_;
+    std::unique_ptr<DomainDecomposition> decomposition_;
+    bool decomposition_current_;                // holds the current state
+    mutable bool state_behind_;
+
+    bool useBlocking() const;
+    bool useTracking() const;
+    bool decomposable() const;
+    bool useDecomposition() const;
+    std::int64_t refreshSteps() const;
+    void advanceDecomposed(std::int64_t steps);
+    // Brings state_ up to date from the decomposition; leaving it also
+    // marks the decomposition out of date, before state_ changes.
+    void synchronize() const;
+    void leaveDecomposition();
+    void trackedStep();
+    void refreshActiveRegion();
+    void updateActiveRange();
+    void setOrigin();
+    void record(const Reduction &r);
+};
+
+#endif // SOLVER_H
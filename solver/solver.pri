@@ -0,0 +1,15 @@
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../solver/release/ -lsolver
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../solver/debug/ -lsolver
+else:unix: LIBS += -L$$OUT_PWD/../solver/ -lsolver
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../solver/release/libsolver.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../solver/debug/libsolver.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../solver/release/solver.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../solver/debug/solver.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../solver/libsolver.a
+
+include(../fftw.pri)
+include(../tracing.pri)
@@ -0,0 +1,76 @@
+#-------------------------------------------------
+#
+# Numerical core of TransportEquation1D: grid parameters, initial profiles,
+# difference schemes and spectra. Does not depend on Qt.
+#
+#-------------------------------------------------
+
+TEMPLATE = lib
+CONFIG += staticlib c++14 thread
+CONFIG -= qt
+
+TARGET = solver
+
+include(../fftw.pri)
+include(../tracing.pri)
+
+SOURCES += \
+    parameters.cpp \
+    field.cpp \
+    blocking.cpp \
+    kernels.cpp \
+    kernels_avx2.cpp \
+    kernels_avx512.cpp \
+    profile.cpp \
+    scheme.cpp \
+    solver.cpp \
+    spectrum.cpp \
+    output.cpp \
+    view.cpp \
+    threadpool.cpp \
+    sweep.cpp \
+    ensemble.cpp \
+    spectral.cpp \
+    convergence.cpp \
+    trace.cpp \
+    stability.cpp \
+    history.cpp \
+    exporter.cpp \
+    tridiagonal.cpp \
+    implicit.cpp \
+    semilagrangian.cpp \
+    highresolution.cpp \
+    amr.cpp \
+    decomposition.cpp \
+    diagnostics.cpp
+
+HEADERS += \
+    parameters.h \
+    field.h \
+    blocking.h \
+    kernels.h \
+    kernels_impl.h \
+    profile.h \
+    scheme.h \
+    solver.h \
+    spectrum.h \
+    output.h \
+    view.h \
+    threadpool.h \
+    sweep.h \
+    ensemble.h \
+    spectral.h \
+    convergence.h \
+    trace.h \
+    stability.h \
+    history.h \
+    exporter.h \
+    tridiagonal.h \
+    implicit.h \
+    semilagrangian.h \
+    highresolution.h \
+    amr.h \
+    decomposition.h \
+    diagnostics.h \
+    snapshot.h \
+    triplebuffer.h
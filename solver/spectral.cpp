@@ -0,0 +1,70 @@
+#include "spectral.h"
+
+#include <cmath>
+
+#include "spectrum.h"
+#include "trace.h"
+
+SpectralPropagator::SpectralPropagator(std::size_t n, double alpha, MethodType method)
+    : period_(n - 1), alpha_(alpha), method_(method), coeffs_(period_/2 + 1)
+{
+    if (method_ == Spectral)
+        return;
+    rates_.resize(coeffs_.size());
+    for (std::size_t k = 0; k < rates_.size(); ++k)
+        rates_[k] = dispersion_diffusion(static_cast<double>(k) / period_, alpha_, method_);
+}
+
+void SpectralPropagator::advance(double *state, std::int64_t steps)
+{
+    TRACE_SCOPE("SpectralPropagator::advance");
+    if (steps <= 0)
+        return;
+
+    forwardTransform(state, period_, coeffs_.data());
+    propagate(coeffs_.data(), steps, state);
+}
+
+void SpectralPropagator::setOrigin(const double *state)
+{
+    origin_.resize(coeffs_.size());
+    forwardTransform(state, period_, origin_.data());
+}
+
+void SpectralPropagator::jump(double *state, std::int64_t steps)
+{
+    TRACE_SCOPE("SpectralPropagator::jump");
+    propagate(origin_.data(), steps, state);
+}
+
+void SpectralPropagator::propagate(const std::complex<double> *from, std::int64_t steps, double *state)
+{
+    const double scale = 1.0 / period_;
+    if (method_ == Spectral)
+    {
+        // Harmonic k moves by alpha cells per step: multiply by exp(-2 pi i k s / N)
+        // with s = alpha*steps, reduced modulo the period to keep the phase exact.
+        const double shift = std::fmod(alpha_ * static_cast<double>(steps), static_cast<double>(period_));
+        for (std::size_t k = 0; k < coeffs_.size(); ++k)
+        {
+            double phase = -2.0*M_PI * static_cast<double>(k) * shift / period_;
+            coeffs_[k] = from[k] * std::polar(scale, phase);
+        }
+    }
+    else
+    {
+        // lambda^steps from the phase and decay per step; the decay of a
+        // harmonic the scheme wipes out in one step is infinite.
+        const double n = static_cast<double>(steps);
+        for (std::size_t k = 0; k < coeffs_.size(); ++k)
+        {
+            double magnitude = steps == 0 ? scale : scale * std::exp(-rates_[k].second * n);
+            coeffs_[k] = from[k] * std::polar(magnitude, -rates_[k].first * n);
+        }
+    }
+    if (period_ % 2 == 0)
+        coeffs_.back() = std::complex<double>(std::real(coeffs_.back()), 0.0);
+
+    inverseTransform(coeffs_.data(), period_, state);
+    state[period_] = state[0];
+}
@@ -0,0 +1,41 @@
+#ifndef SPECTRAL_H
+#define SPECTRAL_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "scheme.h"
+
+// Exact discrete propagator for u_t + u_x = 0 on a periodic grid of n
+// points, the last being the periodic image of the first. Every scheme is
+// linear and translation-invariant, so a step multiplies harmonic k by a
+// fixed factor lambda(k): the exact phase shift for the pseudo-spectral
+// method, the amplification factor of dispersion_diffusion() for the
+// stencil schemes. Any number of steps costs one forward and one inverse
+// transform; a jump from a stored origin only the inverse one.
+class SpectralPropagator
+{
+public:
+    SpectralPropagator(std::size_t n, double alpha, MethodType method = Spectral);
+
+    void advance(double *state, std::int64_t steps);
+
+    // Keeps the spectrum of state, so that jump() can give it advanced by
+    // any number of steps.
+    void setOrigin(const double *state);
+    void jump(double *state, std::int64_t steps);
+
+private:
+    std::size_t period_;
+    double alpha_;
+    MethodType method_;
+    std::vector<std::pair<double, double>> rates_;  // phase and decay per step
+    std::vector<std::complex<double>> origin_, coeffs_;
+
+    void propagate(const std::complex<double> *from, std::int64_t steps, double *state);
+};
+
+#endif // SPECTRAL_H
@@ -0,0 +1,200 @@
+#include "spectrum.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "fftw3.h"
+#include "trace.h"
+
+constexpr std::size_t kPlanCacheSize = 32;
+
+namespace {
+
+struct CachedPlan
+{
+    fftw_plan plan;
+    double *real;
+    fftw_complex *complex;
+};
+
+// FFTW planning is not thread-safe, so the cache lock is held for finding
+// or creating a plan; executing one on the caller's own buffers is, and
+// runs outside it. The planning buffers are only planned on, and plans are
+// made FFTW_UNALIGNED so that any buffers will do. Plans dropped from a full
+// cache may still be executing, so they are destroyed only once no plan is.
+class PlanCache
+{
+public:
+    PlanCache() : effort_(FFTW_ESTIMATE), threads_(1), threads_ready_(false), executing_(0) {}
+
+    ~PlanCache()
+    {
+        clear();
+        destroy(retired_);
+    }
+
+    std::mutex& mutex()
+    {
+        return mutex_;
+    }
+
+    void setEffort(unsigned effort)
+    {
+        effort_ = effort;
+    }
+
+    void setThreads(int threads)
+    {
+#ifdef HAVE_FFTW_THREADS
+        if (!threads_ready_)
+            threads_ready_ = fftw_init_threads() != 0;
+        threads_ = threads_ready_ ? std::max(threads, 1) : 1;
+#else
+        (void) threads;
+#endif
+    }
+
+    // Every acquire() must be followed by a release() once the plan has run.
+    fftw_plan acquire(std::size_t n, bool forward)
+    {
+        ++executing_;
+        return plan(n, forward).plan;
+    }
+
+    void release()
+    {
+        if (--executing_ == 0)
+            destroy(retired_);
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::pair<std::size_t, bool>, CachedPlan> plans_;
+    std::vector<CachedPlan> retired_;
+    unsigned effort_;
+    int threads_;
+    bool threads_ready_;
+    unsigned executing_;
+
+    const CachedPlan& plan(std::size_t n, bool forward)
+    {
+        auto key = std::make_pair(n, forward);
+        auto it = plans_.find(key);
+        if (it != plans_.end())
+            return it->second;
+
+        if (plans_.size() >= kPlanCacheSize)
+            clear();
+
+#ifdef HAVE_FFTW_THREADS
+        if (threads_ready_)
+            fftw_plan_with_nthreads(n >= kThreadedFftSize ? threads_ : 1);
+#endif
+
+        CachedPlan cached;
+        cached.real = fftw_alloc_real(n);
+        cached.complex = fftw_alloc_complex(n/2 + 1);
+        int size = static_cast<int>(n);
+        const unsigned flags = effort_ | FFTW_UNALIGNED;
+        cached.plan = forward ? fftw_plan_dft_r2c_1d(size, cached.real, cached.complex, flags)
+                              : fftw_plan_dft_c2r_1d(size, cached.complex, cached.real, flags);
+        return plans_.emplace(key, cached).first->second;
+    }
+
+    void clear()
+    {
+        for (auto &entry: plans_)
+            retired_.push_back(entry.second);
+        plans_.clear();
+        if (executing_ == 0)
+            destroy(retired_);
+    }
+
+    static void destroy(std::vector<CachedPlan> &plans)
+    {
+        for (auto &cached: plans)
+        {
+            fftw_destroy_plan(cached.plan);
+            fftw_free(cached.real);
+            fftw_free(cached.complex);
+        }
+        plans.clear();
+    }
+};
+
+PlanCache& cache()
+{
+    static PlanCache instance;
+    return instance;
+}
+
+}
+
+void setFftEffort(FftEffort effort)
+{
+    static const unsigned kFlags[] = {FFTW_ESTIMATE, FFTW_MEASURE, FFTW_PATIENT};
+    std::lock_guard<std::mutex> lock(cache().mutex());
+    cache().setEffort(kFlags[effort]);
+}
+
+void setFftThreads(int threads)
+{
+    std::lock_guard<std::mutex> lock(cache().mutex());
+    cache().setThreads(threads);
+}
+
+bool loadFftWisdom(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(cache().mutex());
+    return fftw_import_wisdom_from_filename(path.c_str()) != 0;
+}
+
+bool saveFftWisdom(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(cache().mutex());
+    return fftw_export_wisdom_to_filename(path.c_str()) != 0;
+}
+
+// Out-of-place real-to-complex transforms leave their input alone, so in is
+// passed to FFTW as it is.
+void forwardTransform(const double *in, std::size_t n, std::complex<double> *out)
+{
+    fftw_plan plan;
+    {
+        std::lock_guard<std::mutex> lock(cache().mutex());
+        plan = cache().acquire(n, true);
+    }
+    fftw_execute_dft_r2c(plan, const_cast<double*>(in), reinterpret_cast<fftw_complex*>(out));
+    std::lock_guard<std::mutex> lock(cache().mutex());
+    cache().release();
+}
+
+// Complex-to-real transforms overwrite their input, so it is copied first.
+void inverseTransform(const std::complex<double> *in, std::size_t n, double *out)
+{
+    std::vector<std::complex<double>> coeffs(in, in + n/2 + 1);
+    fftw_plan plan;
+    {
+        std::lock_guard<std::mutex> lock(cache().mutex());
+        plan = cache().acquire(n, false);
+    }
+    fftw_execute_dft_c2r(plan, reinterpret_cast<fftw_complex*>(coeffs.data()), out);
+    std::lock_guard<std::mutex> lock(cache().mutex());
+    cache().release();
+}
+
+std::vector<double> amplitudeSpectrum(const std::vector<double> &state)
+{
+    TRACE_SCOPE("amplitudeSpectrum");
+    auto sp_len = state.size() - 1;
+    std::vector<std::complex<double>> sp(sp_len/2 + 1);
+    forwardTransform(state.data(), sp_len, sp.data());
+
+    std::vector<double> spectrum(sp_len/2);
+    for (decltype(sp_len) i = 0; i < spectrum.size(); ++i)
+        spectrum[i] = std::abs(sp[i]);
+
+    return spectrum;
+}
@@ -0,0 +1,35 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <complex>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Transforms go through a cache of FFTW plans and aligned buffers keyed by
+// length and direction, so only the first transform of a given length pays
+// for planning.
+
+enum FftEffort {FftEstimate, FftMeasure, FftPatient};
+
+// Planner effort for plans created from now on.
+void setFftEffort(FftEffort effort);
+// Threads used by plans of at least kThreadedFftSize points created from now
+// on; 1 disables threading.
+constexpr std::size_t kThreadedFftSize = 1 << 16;
+void setFftThreads(int threads);
+
+bool loadFftWisdom(const std::string &path);
+bool saveFftWisdom(const std::string &path);
+
+// Real-to-complex forward transform of n values into n/2+1 coefficients.
+void forwardTransform(const double *in, std::size_t n, std::complex<double> *out);
+// Complex-to-real inverse of forwardTransform, not normalized (the result
+// is n times the original).
+void inverseTransform(const std::complex<double> *in, std::size_t n, double *out);
+
+// Amplitudes of the first (n-1)/2 harmonics of a periodic grid function
+// sampled at n points, the last point being the periodic image of the first.
+std::vector<double> amplitudeSpectrum(const std::vector<double> &state);
+
+#endif // SPECTRUM_H
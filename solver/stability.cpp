@@ -0,0 +1,219 @@
+#include "stability.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+
+#include "highresolution.h"
+#include "semilagrangian.h"
+#include "threadpool.h"
+#include "trace.h"
+
+// Rows per pool task.
+constexpr std::size_t kStabilityRows = 16;
+
+StabilityMap::StabilityMap()
+    : alphas_(0), wavenumbers_(0), alpha_max_(0.0)
+{
+}
+
+void StabilityMap::compute(std::size_t alphas, std::size_t wavenumbers, double alpha_max, unsigned threads)
+{
+    TRACE_SCOPE("StabilityMap::compute");
+    alphas_ = std::max<std::size_t>(alphas, 2);
+    wavenumbers_ = std::max<std::size_t>(wavenumbers, 2);
+    alpha_max_ = alpha_max;
+    phase_.assign(kMethodCount * alphas_ * wavenumbers_, 0.0);
+    decay_.assign(phase_.size(), 0.0);
+
+    // Only alpha changes along a column.
+    std::vector<double> cosines(wavenumbers_), sines(wavenumbers_);
+    for (std::size_t j = 0; j < wavenumbers_; ++j)
+    {
+        cosines[j] = std::cos(2.0*M_PI * wavenumber(j));
+        sines[j] = std::sin(2.0*M_PI * wavenumber(j));
+    }
+
+    ThreadPool pool(threads);
+    for (int m = 0; m < kMethodCount; ++m)
+    {
+        for (std::size_t first = 0; first < alphas_; first += kStabilityRows)
+        {
+            MethodType type = static_cast<MethodType>(m);
+            std::size_t last = std::min(first + kStabilityRows, alphas_);
+            pool.submit([this, type, first, last, &cosines, &sines] {
+                computeRows(type, first, last, cosines, sines);
+            });
+        }
+    }
+    pool.wait();
+}
+
+// The amplification factor lambda = re + i*im of dispersion_diffusion(),
+// written out per method so that the loops over a row vectorize; phase and
+// decay are its argument and minus the log of its modulus. A harmonic wiped
+// out in one step gets a large finite decay, so slices can interpolate it.
+void StabilityMap::computeRows(MethodType type, std::size_t first, std::size_t last,
+                               const std::vector<double> &cosines, const std::vector<double> &sines)
+{
+    const std::size_t n = wavenumbers_;
+    std::vector<double> re(n), im(n);
+    for (std::size_t row = first; row < last; ++row)
+    {
+        const double a = alpha(row);
+        double *phase = &phase_[offset(type, row)];
+        double *decay = &decay_[offset(type, row)];
+        if (type == Spectral)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+                phase[j] = a * 2.0*M_PI * wavenumber(j);
+            continue;
+        }
+        if (isHighResolutionMethod(type))
+        {
+            // The Runge-Kutta polynomial of the linearized reconstruction;
+            // complex arithmetic is cheap enough for a map computed once.
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                std::complex<double> lambda = highResolutionAmplification(2.0*M_PI * wavenumber(j), a, type);
+                phase[j] = std::arg(lambda);
+                decay[j] = -std::log(std::max(std::abs(lambda), std::numeric_limits<double>::min()));
+            }
+            continue;
+        }
+        if (isSemiLagrangianMethod(type))
+        {
+            // The whole cells of the shift stay out of the wrapped
+            // argument, as in dispersion_diffusion().
+            double w[4];
+            const double p = semiLagrangianWeights(a, type, w);
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                double c2 = cosines[j]*cosines[j] - sines[j]*sines[j];
+                double s2 = 2.0 * sines[j]*cosines[j];
+                double x = w[0]*c2 + (w[1] + w[3])*cosines[j] + w[2];
+                double y = w[0]*s2 + (w[1] - w[3])*sines[j];
+                phase[j] = p * 2.0*M_PI * wavenumber(j) + std::atan2(y, x);
+                decay[j] = -0.5 * std::log(std::max(x*x + y*y, std::numeric_limits<double>::min()));
+            }
+            continue;
+        }
+
+        switch (type)
+        {
+        case Upwind:
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                re[j] = 1.0 - a * (1.0 - cosines[j]);
+                im[j] = a * sines[j];
+            }
+            break;
+        case Lax:
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                re[j] = cosines[j];
+                im[j] = a * sines[j];
+            }
+            break;
+        case LaxWendroff:
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                re[j] = 1.0 - a*a * (1.0 - cosines[j]);
+                im[j] = a * sines[j];
+            }
+            break;
+        case BackwardEuler:
+            // 1 / (1 - i a sin) = (1 + i a sin) / (1 + a^2 sin^2)
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                double scale = 1.0 / (1.0 + a*a * sines[j]*sines[j]);
+                re[j] = scale;
+                im[j] = scale * a * sines[j];
+            }
+            break;
+        case CrankNicolson:
+            // (1 + i a sin/2) / (1 - i a sin/2), of modulus one
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                double h = 0.5 * a * sines[j];
+                double scale = 1.0 / (1.0 + h*h);
+                re[j] = scale * (1.0 - h*h);
+                im[j] = scale * 2.0*h;
+            }
+            break;
+        default:
+            break;
+        }
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            phase[j] = std::atan2(im[j], re[j]);
+            decay[j] = -0.5 * std::log(std::max(re[j]*re[j] + im[j]*im[j], std::numeric_limits<double>::min()));
+        }
+    }
+}
+
+bool StabilityMap::empty() const
+{
+    return phase_.empty();
+}
+
+std::size_t StabilityMap::alphas() const
+{
+    return alphas_;
+}
+
+std::size_t StabilityMap::wavenumbers() const
+{
+    return wavenumbers_;
+}
+
+double StabilityMap::alphaMax() const
+{
+    return alpha_max_;
+}
+
+double StabilityMap::alpha(std::size_t row) const
+{
+    return alpha_max_ * row / (alphas_ - 1);
+}
+
+double StabilityMap::wavenumber(std::size_t column) const
+{
+    return 0.5 * column / (wavenumbers_ - 1);
+}
+
+const double* StabilityMap::phase(MethodType type, std::size_t row) const
+{
+    return &phase_[offset(type, row)];
+}
+
+const double* StabilityMap::decay(MethodType type, std::size_t row) const
+{
+    return &decay_[offset(type, row)];
+}
+
+bool StabilityMap::slice(MethodType type, double alpha, std::vector<double> &phase, std::vector<double> &decay) const
+{
+    if (empty() || !(alpha >= 0.0 && alpha <= alpha_max_))
+        return false;
+
+    double position = alpha / alpha_max_ * (alphas_ - 1);
+    std::size_t row = std::min(static_cast<std::size_t>(position), alphas_ - 2);
+    double w = position - row;
+    const double *phase0 = this->phase(type, row), *phase1 = this->phase(type, row + 1);
+    const double *decay0 = this->decay(type, row), *decay1 = this->decay(type, row + 1);
+    phase.resize(wavenumbers_);
+    decay.resize(wavenumbers_);
+    for (std::size_t j = 0; j < wavenumbers_; ++j)
+    {
+        phase[j] = phase0[j] + w * (phase1[j] - phase0[j]);
+        decay[j] = decay0[j] + w * (decay1[j] - decay0[j]);
+    }
+    return true;
+}
+
+std::size_t StabilityMap::offset(MethodType type, std::size_t row) const
+{
+    return (static_cast<std::size_t>(type) * alphas_ + row) * wavenumbers_;
+}
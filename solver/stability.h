@@ -0,0 +1,50 @@
+#ifndef STABILITY_H
+#define STABILITY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "scheme.h"
+
+// Rows of CFL numbers and columns of wavenumbers of the map the GUI keeps.
+constexpr std::size_t kStabilityAlphas = 512;
+constexpr std::size_t kStabilityWavenumbers = 512;
+constexpr double kStabilityAlphaMax = 2.0;
+
+// Phase and amplitude error per step, as dispersion_diffusion() gives them,
+// of every method over a grid of CFL numbers alpha in [0, alpha_max] (rows)
+// and wavenumbers q_N in [0, 0.5] (columns). Neither depends on nx, so one
+// map serves every grid.
+class StabilityMap
+{
+public:
+    StabilityMap();
+
+    // Fills the map on a pool of threads (0 means one per core).
+    void compute(std::size_t alphas, std::size_t wavenumbers, double alpha_max, unsigned threads = 0);
+
+    bool empty() const;
+    std::size_t alphas() const;
+    std::size_t wavenumbers() const;
+    double alphaMax() const;
+    double alpha(std::size_t row) const;
+    double wavenumber(std::size_t column) const;
+
+    const double* phase(MethodType type, std::size_t row) const;
+    const double* decay(MethodType type, std::size_t row) const;
+
+    // The curves at alpha, interpolated between the two nearest rows; false
+    // if alpha lies outside the map.
+    bool slice(MethodType type, double alpha, std::vector<double> &phase, std::vector<double> &decay) const;
+
+private:
+    std::size_t alphas_, wavenumbers_;
+    double alpha_max_;
+    std::vector<double> phase_, decay_;
+
+    std::size_t offset(MethodType type, std::size_t row) const;
+    void computeRows(MethodType type, std::size_t first, std::size_t last,
+                     const std::vector<double> &cosines, const std::vector<double> &sines);
+};
+
+#endif // STABILITY_H
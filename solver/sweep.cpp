@@ -0,0 +1,132 @@
+#include "sweep.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "ensemble.h"
+#include "solver.h"
+#include "threadpool.h"
+
+std::vector<SweepCase> crossProduct(const std::vector<InitialProfile> &profiles, const std::vector<MethodType> &methods,
+                                    const std::vector<std::int64_t> &nxs, const std::vector<std::int64_t> &nts)
+{
+    std::vector<SweepCase> cases;
+    for (auto profile: profiles)
+        for (auto method: methods)
+            for (auto nx: nxs)
+                for (auto nt: nts)
+                    cases.push_back(SweepCase{profile, method, nx, nt});
+    return cases;
+}
+
+static SweepResult runCase(const SweepCase &run)
+{
+    auto start = std::chrono::steady_clock::now();
+    Solver solver(Parameters(run.nx, run.nt, kRangeX, kRangeT), run.profile, run.method);
+    solver.run();
+    const Diagnostics &last = solver.diagnostics().latest();
+    auto finish = std::chrono::steady_clock::now();
+
+    SweepResult result;
+    result.run = run;
+    result.alpha = solver.parameters().get_alpha();
+    result.steps = solver.steps();
+    result.diverged = solver.diverged();
+    result.min = last.min;
+    result.max = last.max;
+    result.seconds = std::chrono::duration<double>(finish - start).count();
+    return result;
+}
+
+std::vector<SweepResult> runSweep(const std::vector<SweepCase> &cases, unsigned threads)
+{
+    std::vector<SweepResult> results(cases.size());
+
+    std::vector<std::size_t> order(cases.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&cases](std::size_t a, std::size_t b) {
+        return static_cast<double>(cases[a].nx) * cases[a].nt > static_cast<double>(cases[b].nx) * cases[b].nt;
+    });
+
+    ThreadPool pool(threads);
+    for (auto index: order)
+        pool.submit([&cases, &results, index] { results[index] = runCase(cases[index]); });
+    pool.wait();
+
+    return results;
+}
+
+std::vector<SweepResult> runEnsembleSweep(const std::vector<SweepCase> &cases, unsigned threads)
+{
+    std::vector<SweepResult> results(cases.size());
+
+    ThreadPool pool(threads);
+
+    std::vector<std::size_t> order;
+    for (std::size_t index = 0; index < cases.size(); ++index)
+    {
+        if (isStencilMethod(cases[index].method))
+            order.push_back(index);
+        else
+            pool.submit([&cases, &results, index] { results[index] = runCase(cases[index]); });
+    }
+    std::stable_sort(order.begin(), order.end(), [&cases](std::size_t a, std::size_t b) {
+        return cases[a].nx < cases[b].nx;
+    });
+
+    for (std::size_t first = 0; first < order.size(); )
+    {
+        std::int64_t nx = cases[order[first]].nx;
+        std::size_t chunk = std::max<std::size_t>(1, std::min<std::size_t>(256, kEnsembleCells / nx));
+        std::size_t last = first;
+        while (last < order.size() && last - first < chunk && cases[order[last]].nx == nx)
+            ++last;
+
+        std::vector<std::size_t> group(order.begin() + first, order.begin() + last);
+        pool.submit([&cases, &results, group, nx] {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<EnsembleMember> members;
+            for (auto index: group)
+                members.push_back(EnsembleMember{cases[index].profile, cases[index].method, cases[index].nt});
+            Ensemble ensemble(nx, members);
+            ensemble.run();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            for (std::size_t m = 0; m < group.size(); ++m)
+            {
+                std::vector<double> state = ensemble.state(m);
+                auto minmax = std::minmax_element(state.begin(), state.end());
+                SweepResult &result = results[group[m]];
+                result.run = cases[group[m]];
+                result.alpha = ensemble.alpha(m);
+                result.steps = ensemble.steps(m);
+                result.diverged = std::any_of(state.begin(), state.end(), [](double u) {
+                    return !(std::abs(u) <= kBlowUpLimit);
+                });
+                result.min = *minmax.first;
+                result.max = *minmax.second;
+                result.seconds = seconds / group.size();
+            }
+        });
+        first = last;
+    }
+    pool.wait();
+
+    return results;
+}
+
+void writeSweepTable(std::ostream &out, const std::vector<SweepResult> &results)
+{
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "profile\tmethod\tnx\tnt\talpha\tsteps\tdiverged\tmin\tmax\tseconds\n";
+    for (const auto &result: results)
+    {
+        out << profileName(result.run.profile) << "\t" << methodName(result.run.method) << "\t"
+            << result.run.nx << "\t" << result.run.nt << "\t" << result.alpha << "\t"
+            << result.steps << "\t" << (result.diverged ? 1 : 0) << "\t"
+            << result.min << "\t" << result.max << "\t" << result.seconds << "\n";
+    }
+}
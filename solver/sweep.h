@@ -0,0 +1,49 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "profile.h"
+#include "scheme.h"
+
+struct SweepCase
+{
+    InitialProfile profile;
+    MethodType method;
+    std::int64_t nx, nt;
+};
+
+struct SweepResult
+{
+    SweepCase run;
+    double alpha;
+    std::int64_t steps;
+    bool diverged;
+    double min, max;
+    double seconds;
+};
+
+std::vector<SweepCase> crossProduct(const std::vector<InitialProfile> &profiles, const std::vector<MethodType> &methods,
+                                    const std::vector<std::int64_t> &nxs, const std::vector<std::int64_t> &nts);
+
+// Runs every case to kRangeT on a work-stealing pool (threads = 0 means one
+// per core). Cases are queued most expensive first; results come back in
+// the order of cases.
+std::vector<SweepResult> runSweep(const std::vector<SweepCase> &cases, unsigned threads = 0);
+
+// Same as runSweep, but cases with equal nx are advanced together as
+// Ensembles of up to kEnsembleCells/nx members, one Ensemble per pool task.
+// Suited to many small grids. Only the three-point stencil schemes have an
+// Ensemble kernel; cases of every other method are run one by one. Blown-up
+// members are not stopped early, so their steps are always nt and seconds is
+// the ensemble time per member.
+constexpr std::size_t kEnsembleCells = std::size_t(1) << 22;
+std::vector<SweepResult> runEnsembleSweep(const std::vector<SweepCase> &cases, unsigned threads = 0);
+
+// One tab-separated row per result, with a header line.
+void writeSweepTable(std::ostream &out, const std::vector<SweepResult> &results);
+
+#endif // SWEEP_H
@@ -0,0 +1,123 @@
+#include "threadpool.h"
+
+#include <algorithm>
+
+namespace {
+
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local unsigned current_index = 0;
+
+}
+
+ThreadPool::ThreadPool(unsigned threads)
+    : next_(0), queued_(0), pending_(0), stop_(false)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < threads; ++i)
+        queues_.emplace_back(new Queue);
+    for (unsigned i = 0; i < threads; ++i)
+        workers_.emplace_back(&ThreadPool::work, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker: workers_)
+        worker.join();
+}
+
+unsigned ThreadPool::size() const
+{
+    return static_cast<unsigned>(workers_.size());
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    const bool spawned = current_pool == this;
+    unsigned index = spawned ? current_index : next_.fetch_add(1, std::memory_order_relaxed) % size();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queued_;
+        ++pending_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        (spawned ? queues_[index]->spawned : queues_[index]->tasks).push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+}
+
+bool ThreadPool::take(unsigned index, std::function<void()> &task)
+{
+    {
+        Queue &own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.spawned.empty())
+        {
+            task = std::move(own.spawned.back());
+            own.spawned.pop_back();
+            return true;
+        }
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    for (unsigned i = 1; i < size(); ++i)
+    {
+        Queue &victim = *queues_[(index + i) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        auto &tasks = !victim.tasks.empty() ? victim.tasks : victim.spawned;
+        if (!tasks.empty())
+        {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::work(unsigned index)
+{
+    current_pool = this;
+    current_index = index;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+            if (stop_ && queued_ == 0)
+                return;
+        }
+
+        std::function<void()> task;
+        if (!take(index, task))
+            continue;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --queued_;
+        }
+
+        task();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0)
+            done_.notify_all();
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads with two task deques each. Tasks submitted
+// from outside are dealt round-robin and run in submission order, so a
+// caller that submits the most expensive first gets them started first.
+// Tasks submitted from inside a task go to the submitting worker's own
+// deque, which it takes newest first while they are still in cache. A
+// worker with nothing left steals the oldest task of another, so uneven
+// task costs even out on their own.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const;
+
+    void submit(std::function<void()> task);
+    // Blocks until every submitted task has finished.
+    void wait();
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;       // submitted from outside
+        std::deque<std::function<void()>> spawned;     // submitted by the worker itself
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<unsigned> next_;
+    std::size_t queued_;
+    std::size_t pending_;
+    bool stop_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    void work(unsigned index);
+    bool take(unsigned index, std::function<void()> &task);
+};
+
+#endif // THREADPOOL_H
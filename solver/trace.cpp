@@ -0,0 +1,140 @@
+#include "trace.h"
+
+#ifdef TRANSPORT_TRACING
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+struct TraceEvent
+{
+    const char *name;
+    std::int64_t start, duration;   // nanoseconds
+};
+
+// One per thread, so recording only ever takes an uncontended lock; the
+// lock is there for the readers below.
+struct TraceBuffer
+{
+    std::mutex mutex;
+    int tid;
+    std::vector<TraceEvent> events;
+    std::vector<TracePhase> totals;
+};
+
+std::mutex registry_mutex;
+
+// Buffers outlive their threads, so a finished solver run still shows up.
+std::vector<std::unique_ptr<TraceBuffer>>& registry()
+{
+    static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    return buffers;
+}
+
+TraceBuffer& threadBuffer()
+{
+    thread_local TraceBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        registry().emplace_back(new TraceBuffer);
+        buffer = registry().back().get();
+        buffer->tid = static_cast<int>(registry().size());
+    }
+    return *buffer;
+}
+
+std::int64_t now()
+{
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void addTotal(std::vector<TracePhase> &totals, const char *name, std::int64_t calls, double seconds)
+{
+    for (auto &phase: totals)
+    {
+        if (phase.name == name || std::strcmp(phase.name, name) == 0)
+        {
+            phase.calls += calls;
+            phase.seconds += seconds;
+            return;
+        }
+    }
+    totals.push_back(TracePhase{name, calls, seconds});
+}
+
+void writeString(std::ostream &out, const char *text)
+{
+    out << '"';
+    for (const char *c = text; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+TraceScope::TraceScope(const char *name)
+    : name_(name), start_(now())
+{
+}
+
+TraceScope::~TraceScope()
+{
+    std::int64_t duration = now() - start_;
+    TraceBuffer &buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() < kTraceEvents)
+        buffer.events.push_back(TraceEvent{name_, start_, duration});
+    addTotal(buffer.totals, name_, 1, duration * 1e-9);
+}
+
+std::vector<TracePhase> traceTotals()
+{
+    std::vector<TracePhase> totals;
+    std::lock_guard<std::mutex> registry_lock(registry_mutex);
+    for (const auto &buffer: registry())
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        for (const auto &phase: buffer->totals)
+            addTotal(totals, phase.name, phase.calls, phase.seconds);
+    }
+    return totals;
+}
+
+bool writeChromeTrace(const std::string &path)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::lock_guard<std::mutex> registry_lock(registry_mutex);
+    for (const auto &buffer: registry())
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        for (const auto &event: buffer->events)
+        {
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"ts\":" << event.start * 1e-3 << ",\"dur\":" << event.duration * 1e-3 << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+#endif // TRANSPORT_TRACING
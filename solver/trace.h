@@ -0,0 +1,70 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Scoped wall-clock timers for the hot paths. They are recorded only in
+// builds with TRANSPORT_TRACING (qmake CONFIG+=tracing); otherwise
+// TRACE_SCOPE expands to nothing and the functions below are empty inlines.
+
+struct TracePhase
+{
+    const char *name;
+    std::int64_t calls;
+    double seconds;
+};
+
+#ifdef TRANSPORT_TRACING
+
+constexpr bool kTracing = true;
+
+// Times its own lifetime. name must be a string literal (it is kept as a
+// pointer).
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char *name_;
+    std::int64_t start_;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+
+// Calls and time per scope name, summed over all threads since start.
+std::vector<TracePhase> traceTotals();
+
+// Every recorded scope as a Chrome trace ("X" events), for chrome://tracing
+// or Perfetto. Each thread keeps at most kTraceEvents events; later ones are
+// only counted in the totals.
+constexpr std::size_t kTraceEvents = std::size_t(1) << 20;
+bool writeChromeTrace(const std::string &path);
+
+#else
+
+constexpr bool kTracing = false;
+
+#define TRACE_SCOPE(name) ((void)0)
+
+inline std::vector<TracePhase> traceTotals()
+{
+    return std::vector<TracePhase>();
+}
+
+inline bool writeChromeTrace(const std::string &)
+{
+    return false;
+}
+
+#endif // TRANSPORT_TRACING
+
+#endif // TRACE_H
@@ -0,0 +1,250 @@
+#include "tridiagonal.h"
+
+#include <algorithm>
+
+#include "threadpool.h"
+#include "trace.h"
+
+namespace {
+
+// Splits [0, n) into one run per thread, in multiples of a cache line of
+// doubles so that no two threads write to the same line.
+template <typename Function>
+void forChunks(ThreadPool &pool, std::size_t n, Function function)
+{
+    const std::size_t threads = pool.size();
+    std::size_t chunk = (n + threads - 1) / threads;
+    chunk = (chunk + 7) / 8 * 8;
+    for (std::size_t begin = 0; begin < n; begin += chunk)
+    {
+        std::size_t end = std::min(begin + chunk, n);
+        pool.submit([&function, begin, end] { function(begin, end); });
+    }
+    pool.wait();
+}
+
+}
+
+TridiagonalSolver::TridiagonalSolver()
+    : n_(0), lower_(0.0), diagonal_(1.0), upper_(0.0), first_(1.0), last_(1.0), systems_(1)
+{
+}
+
+TridiagonalSolver::~TridiagonalSolver()
+{
+}
+
+void TridiagonalSolver::factor(std::size_t n, double lower, double diagonal, double upper,
+                               double first, double last, unsigned threads)
+{
+    n_ = n;
+    lower_ = lower;
+    diagonal_ = diagonal;
+    upper_ = upper;
+    first_ = first;
+    last_ = n > 1 ? last : first;
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > 1 && n >= kParallelSolveCells)
+    {
+        upper_pivot_.clear();
+        inverse_pivot_.clear();
+        if (!pool_ || pool_->size() != threads)
+            pool_.reset(new ThreadPool(threads));
+        // Enough interleaved systems for every thread to eliminate whole
+        // cache lines of them.
+        systems_ = 1;
+        while (systems_ < 8 * std::size_t(threads))
+            systems_ *= 2;
+        for (auto *v: {&a_, &b_, &c_, &d_, &next_a_, &next_b_, &next_c_, &next_d_})
+            v->resize(n);
+        return;
+    }
+
+    pool_.reset();
+    for (auto *v: {&a_, &b_, &c_, &d_, &next_a_, &next_b_, &next_c_, &next_d_})
+        std::vector<double>().swap(*v);
+    upper_pivot_.resize(n);
+    inverse_pivot_.resize(n);
+    double pivot = first_;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i > 0)
+            pivot = (i+1 == n ? last_ : diagonal_) - lower_ * upper_pivot_[i-1];
+        inverse_pivot_[i] = 1.0 / pivot;
+        upper_pivot_[i] = upper_ * inverse_pivot_[i];
+    }
+}
+
+void TridiagonalSolver::solve(double *d)
+{
+    TRACE_SCOPE("TridiagonalSolver::solve");
+    if (n_ == 0)
+        return;
+    if (pool_)
+    {
+        solveParallel(d);
+        return;
+    }
+
+    d[0] *= inverse_pivot_[0];
+    for (std::size_t i = 1; i < n_; ++i)
+        d[i] = (d[i] - lower_ * d[i-1]) * inverse_pivot_[i];
+    for (std::size_t i = n_ - 1; i-- > 0; )
+        d[i] -= upper_pivot_[i] * d[i+1];
+}
+
+std::size_t TridiagonalSolver::size() const
+{
+    return n_;
+}
+
+bool TridiagonalSolver::parallel() const
+{
+    return pool_ != nullptr;
+}
+
+void TridiagonalSolver::solveParallel(double *d)
+{
+    forChunks(*pool_, n_, [this, d](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            a_[i] = i > 0 ? lower_ : 0.0;
+            b_[i] = i == 0 ? first_ : i+1 == n_ ? last_ : diagonal_;
+            c_[i] = i+1 < n_ ? upper_ : 0.0;
+            d_[i] = d[i];
+        }
+    });
+
+    for (std::size_t stride = 1; stride < systems_; stride *= 2)
+    {
+        forChunks(*pool_, n_, [this, stride](std::size_t begin, std::size_t end) {
+            reduceRows(stride, begin, end);
+        });
+        a_.swap(next_a_);
+        b_.swap(next_b_);
+        c_.swap(next_c_);
+        d_.swap(next_d_);
+    }
+
+    forChunks(*pool_, std::min(systems_, n_), [this](std::size_t begin, std::size_t end) {
+        eliminateSystems(begin, end);
+    });
+
+    forChunks(*pool_, n_, [this, d](std::size_t begin, std::size_t end) {
+        std::copy(d_.begin() + begin, d_.begin() + end, d + begin);
+    });
+}
+
+// Row i takes away multiples of rows i - stride and i + stride so that it
+// no longer refers to their unknowns, only to those at twice the stride.
+// Rows within stride of an end have nothing on that side to remove.
+void TridiagonalSolver::reduceRows(std::size_t stride, std::size_t begin, std::size_t end)
+{
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        double a = 0.0, b = b_[i], c = 0.0, d = d_[i];
+        if (i >= stride)
+        {
+            double k = a_[i] / b_[i-stride];
+            a = -k * a_[i-stride];
+            b -= k * c_[i-stride];
+            d -= k * d_[i-stride];
+        }
+        if (i + stride < n_)
+        {
+            double k = c_[i] / b_[i+stride];
+            c = -k * c_[i+stride];
+            b -= k * a_[i+stride];
+            d -= k * d_[i+stride];
+        }
+        next_a_[i] = a;
+        next_b_[i] = b;
+        next_c_[i] = c;
+        next_d_[i] = d;
+    }
+}
+
+// Plain elimination of the systems made of rows r, r + s, r + 2s, ... for
+// r in [begin, end), one row of all of them at a time, so that the inner
+// loop runs over adjacent cells.
+void TridiagonalSolver::eliminateSystems(std::size_t begin, std::size_t end)
+{
+    const std::size_t s = systems_;
+    const std::size_t rows = (n_ + s - 1) / s;
+    for (std::size_t j = 0; j < rows; ++j)
+    {
+        const std::size_t row = j * s;
+        const std::size_t last = std::min(end, n_ - row);
+        for (std::size_t r = begin; r < last; ++r)
+        {
+            std::size_t i = row + r;
+            double pivot = j > 0 ? b_[i] - a_[i] * c_[i-s] : b_[i];
+            double previous = j > 0 ? a_[i] * d_[i-s] : 0.0;
+            c_[i] /= pivot;
+            d_[i] = (d_[i] - previous) / pivot;
+        }
+    }
+    for (std::size_t j = rows; j-- > 0; )
+    {
+        const std::size_t row = j * s;
+        const std::size_t last = std::min(end, n_ - row);
+        for (std::size_t r = begin; r < last; ++r)
+        {
+            std::size_t i = row + r;
+            if (i + s < n_)
+                d_[i] -= c_[i] * d_[i+s];
+        }
+    }
+}
+
+CyclicTridiagonalSolver::CyclicTridiagonalSolver()
+    : gamma_(0.0), ratio_(0.0), denominator_(1.0)
+{
+}
+
+// A = T + u v^T with u = (gamma, 0, ..., 0, upper) and v = (1, 0, ..., 0,
+// lower/gamma), T keeping the bands with diagonal - gamma and diagonal -
+// upper*lower/gamma in its corners. The textbook gamma = -diagonal leaves
+// diagonal + upper*lower/diagonal in the last row, which cancels once the
+// off-diagonal bands outgrow the diagonal, as they do for lower = -upper at
+// CFL numbers above one; gamma = diagonal/2 keeps both corners at least
+// half the diagonal for those.
+void CyclicTridiagonalSolver::factor(std::size_t n, double lower, double diagonal, double upper, unsigned threads)
+{
+    if (n < 2)
+    {
+        gamma_ = 0.0;
+        tridiagonal_.factor(n, 0.0, diagonal, 0.0, lower + diagonal + upper, lower + diagonal + upper);
+        return;
+    }
+
+    gamma_ = 0.5 * diagonal;
+    ratio_ = lower / gamma_;
+    tridiagonal_.factor(n, lower, diagonal, upper, diagonal - gamma_, diagonal - upper * ratio_, threads);
+
+    z_.assign(n, 0.0);
+    z_[0] = gamma_;
+    z_[n-1] = upper;
+    tridiagonal_.solve(z_.data());
+    denominator_ = 1.0 + z_[0] + ratio_ * z_[n-1];
+}
+
+void CyclicTridiagonalSolver::solve(double *d)
+{
+    TRACE_SCOPE("CyclicTridiagonalSolver::solve");
+    const std::size_t n = tridiagonal_.size();
+    tridiagonal_.solve(d);
+    if (gamma_ == 0.0)
+        return;
+
+    double factor = (d[0] + ratio_ * d[n-1]) / denominator_;
+    for (std::size_t i = 0; i < n; ++i)
+        d[i] -= factor * z_[i];
+}
+
+std::size_t CyclicTridiagonalSolver::size() const
+{
+    return tridiagonal_.size();
+}
@@ -0,0 +1,72 @@
+#ifndef TRIDIAGONAL_H
+#define TRIDIAGONAL_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class ThreadPool;
+
+// Systems of n unknowns whose bands are constant,
+//     lower*x[i-1] + diagonal*x[i] + upper*x[i+1] = d[i],
+// except that the first and last rows have their own diagonal. The
+// elimination depends on the bands only, so factor() runs it once and each
+// solve() is one forward and one backward pass over d.
+//
+// Grids of at least kParallelSolveCells on more than one thread are solved
+// by parallel cyclic reduction instead: log2(s) rounds in which every row
+// eliminates its neighbours at distance 1, 2, 4, ..., leave s independent
+// interleaved systems, which the threads then eliminate side by side.
+constexpr std::size_t kParallelSolveCells = std::size_t(1) << 20;
+
+class TridiagonalSolver
+{
+public:
+    TridiagonalSolver();
+    ~TridiagonalSolver();
+
+    // threads as for ThreadPool: 0 means one per core.
+    void factor(std::size_t n, double lower, double diagonal, double upper,
+                double first, double last, unsigned threads = 1);
+    // Overwrites d with x.
+    void solve(double *d);
+
+    std::size_t size() const;
+    bool parallel() const;
+
+private:
+    std::size_t n_;
+    double lower_, diagonal_, upper_, first_, last_;
+    std::vector<double> upper_pivot_;   // upper / pivot of each row
+    std::vector<double> inverse_pivot_;
+    std::unique_ptr<ThreadPool> pool_;
+    std::size_t systems_;               // s, a power of two
+    std::vector<double> a_, b_, c_, d_, next_a_, next_b_, next_c_, next_d_;
+
+    void solveParallel(double *d);
+    void reduceRows(std::size_t stride, std::size_t begin, std::size_t end);
+    void eliminateSystems(std::size_t begin, std::size_t end);
+};
+
+// The periodic system: row 0 couples to x[n-1] through lower and row n-1
+// to x[0] through upper. The two corners are a rank-one correction of a
+// plain tridiagonal system (Sherman-Morrison), so a solve costs one plain
+// solve and one more pass.
+class CyclicTridiagonalSolver
+{
+public:
+    CyclicTridiagonalSolver();
+
+    void factor(std::size_t n, double lower, double diagonal, double upper, unsigned threads = 1);
+    void solve(double *d);
+
+    std::size_t size() const;
+
+private:
+    TridiagonalSolver tridiagonal_;
+    std::vector<double> z_;             // the plain system solved for the correction
+    double gamma_, ratio_;              // ratio = lower / gamma, the last entry of v
+    double denominator_;                // 1 + v.z
+};
+
+#endif // TRIDIAGONAL_H
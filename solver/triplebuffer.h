@@ -0,0 +1,51 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Single-producer single-consumer triple buffer. The writer fills back() and
+// publishes it, the reader picks up the most recent published value with
+// update(); neither side ever blocks the other.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() : back_(0), front_(2), middle_(1) {}
+
+    T& back()
+    {
+        return buffers_[back_];
+    }
+
+    void publish()
+    {
+        back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndex;
+    }
+
+    bool consumed() const
+    {
+        return !(middle_.load(std::memory_order_acquire) & kFresh);
+    }
+
+    bool update()
+    {
+        if (!(middle_.load(std::memory_order_relaxed) & kFresh))
+            return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+        return true;
+    }
+
+    const T& front() const
+    {
+        return buffers_[front_];
+    }
+
+private:
+    enum {kIndex = 3, kFresh = 4};
+
+    T buffers_[3];
+    int back_, front_;
+    std::atomic<int> middle_;
+};
+
+#endif // TRIPLEBUFFER_H
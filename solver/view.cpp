@@ -0,0 +1,75 @@
+#include "view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+void reduceEnvelope(const double *u, std::size_t n, double dx, std::size_t columns, Envelope &envelope)
+{
+    std::size_t count = std::min(n, std::max<std::size_t>(columns, 1));
+    envelope.x_begin = 0.0;
+    envelope.x_end = n > 0 ? (n - 1) * dx : 0.0;
+    envelope.lo.resize(count);
+    envelope.hi.resize(count);
+
+    for (std::size_t c = 0; c < count; ++c)
+    {
+        std::size_t first = static_cast<std::size_t>(static_cast<std::uint64_t>(c) * n / count);
+        std::size_t last = static_cast<std::size_t>(static_cast<std::uint64_t>(c + 1) * n / count);
+        double lo = u[first], hi = u[first];
+        for (std::size_t i = first + 1; i < last; ++i)
+        {
+            lo = std::min(lo, u[i]);
+            hi = std::max(hi, u[i]);
+        }
+        envelope.lo[c] = lo;
+        envelope.hi[c] = hi;
+    }
+}
+
+void envelopePolyline(const Envelope &envelope, double x0, double x1, std::size_t columns,
+                      std::vector<double> &x, std::vector<double> &values)
+{
+    x.clear();
+    values.clear();
+    const std::size_t count = envelope.lo.size();
+    if (count == 0 || columns == 0)
+        return;
+
+    const double width = count > 1 ? (envelope.x_end - envelope.x_begin) / (count - 1) : 1.0;
+    auto column = [&](double at) {
+        double c = (at - envelope.x_begin) / width;
+        return static_cast<std::size_t>(std::min(std::max(c, 0.0), static_cast<double>(count - 1)));
+    };
+    // One column more on either side, so the line runs to the plot edges.
+    std::size_t first = column(x0);
+    std::size_t last = std::min(column(x1) + 1, count - 1);
+    std::size_t visible = last - first + 1;
+    std::size_t groups = std::min(visible, columns);
+
+    double previous = envelope.lo[first];
+    for (std::size_t g = 0; g < groups; ++g)
+    {
+        std::size_t a = first + g * visible / groups;
+        std::size_t b = first + (g + 1) * visible / groups;
+        double lo = *std::min_element(envelope.lo.begin() + a, envelope.lo.begin() + b);
+        double hi = *std::max_element(envelope.hi.begin() + a, envelope.hi.begin() + b);
+        // Groups sit at their centres, the outer ones at the outer columns.
+        double centre = g == 0 ? a : g + 1 == groups ? b - 1 : 0.5 * (a + b - 1);
+        double at = envelope.x_begin + width * centre;
+
+        if (lo == hi)
+        {
+            x.push_back(at);
+            values.push_back(lo);
+            previous = lo;
+            continue;
+        }
+        bool down = std::abs(previous - hi) < std::abs(previous - lo);
+        x.push_back(at);
+        values.push_back(down ? hi : lo);
+        x.push_back(at);
+        values.push_back(down ? lo : hi);
+        previous = down ? lo : hi;
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <cstddef>
+#include <vector>
+
+// Columns of the envelope a snapshot carries; displays never have to touch
+// the full grid.
+constexpr std::size_t kViewPoints = 4096;
+// Bars of the spectrum histogram and samples of the dispersion/dissipation
+// curves; both are independent of nx.
+constexpr int kSpectrumBars = 256;
+constexpr int kCurvePoints = 512;
+
+// Minimum and maximum of a grid function over each of a number of equally
+// wide columns. With no more cells than columns every cell is its own
+// column and the envelope is exact. Column c sits at
+// x_begin + c*(x_end - x_begin)/(columns - 1).
+struct Envelope
+{
+    double x_begin = 0.0, x_end = 0.0;
+    std::vector<double> lo, hi;
+};
+
+void reduceEnvelope(const double *u, std::size_t n, double dx, std::size_t columns, Envelope &envelope);
+
+// The part of the envelope over [x0, x1], merged down to at most columns
+// columns (one per pixel), as a polyline: a single point where a column is
+// flat, otherwise a vertical segment ordered to continue from the previous
+// point. Spikes narrower than a pixel therefore stay visible.
+void envelopePolyline(const Envelope &envelope, double x0, double x1, std::size_t columns,
+                      std::vector<double> &x, std::vector<double> &values);
+
+#endif // VIEW_H
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "sweep.h"
+
+static void usage(const char *name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --profiles LIST    comma-separated profiles or all (all)\n"
+              << "  --methods LIST     comma-separated methods or all (all)\n"
+              << "  --nx LIST          comma-separated numbers of spatial points (65,129,257)\n"
+              << "  --nt LIST          comma-separated numbers of time steps (100,200,400)\n"
+              << "  --ensemble         advance cases with equal nx together (for small grids)\n"
+              << "  --threads N        worker threads, 0 for one per core (0)\n"
+              << "  --output FILE      write the table to FILE instead of stdout\n";
+}
+
+static std::vector<std::string> split(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+static bool parseProfiles(const std::string &list, std::vector<InitialProfile> *profiles)
+{
+    profiles->clear();
+    if (list == "all")
+    {
+        *profiles = allProfiles();
+        return true;
+    }
+    for (const auto &item: split(list))
+    {
+        InitialProfile profile;
+        if (!profileFromName(item, &profile))
+            return false;
+        profiles->push_back(profile);
+    }
+    return !profiles->empty();
+}
+
+static bool parseMethods(const std::string &list, std::vector<MethodType> *methods)
+{
+    methods->clear();
+    if (list == "all")
+    {
+        *methods = allMethods();
+        return true;
+    }
+    for (const auto &item: split(list))
+    {
+        MethodType method;
+        if (!methodFromName(item, &method))
+            return false;
+        methods->push_back(method);
+    }
+    return !methods->empty();
+}
+
+static bool parseSizes(const std::string &list, std::int64_t min, std::vector<std::int64_t> *sizes)
+{
+    sizes->clear();
+    for (const auto &item: split(list))
+    {
+        std::int64_t size = std::atoll(item.c_str());
+        if (size < min)
+            return false;
+        sizes->push_back(size);
+    }
+    return !sizes->empty();
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<InitialProfile> profiles = allProfiles();
+    std::vector<MethodType> methods = allMethods();
+    std::vector<std::int64_t> nxs = {65, 129, 257};
+    std::vector<std::int64_t> nts = {100, 200, 400};
+    unsigned threads = 0;
+    bool ensemble = false;
+    std::string output;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+        {
+            usage(argv[0]);
+            return 0;
+        }
+        if (arg == "--ensemble")
+        {
+            ensemble = true;
+            continue;
+        }
+        if (i+1 >= argc)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        bool ok = false;
+        if (arg == "--profiles")
+            ok = parseProfiles(value, &profiles);
+        else if (arg == "--methods")
+            ok = parseMethods(value, &methods);
+        else if (arg == "--nx")
+            ok = parseSizes(value, 3, &nxs);
+        else if (arg == "--nt")
+            ok = parseSizes(value, 1, &nts);
+        else if (arg == "--threads")
+        {
+            threads = static_cast<unsigned>(std::atoi(value.c_str()));
+            ok = true;
+        }
+        else if (arg == "--output")
+        {
+            output = value;
+            ok = true;
+        }
+        if (!ok)
+        {
+            std::cerr << "Invalid option " << arg << " " << value << "\n";
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<SweepCase> cases = crossProduct(profiles, methods, nxs, nts);
+    std::vector<SweepResult> results = ensemble ? runEnsembleSweep(cases, threads) : runSweep(cases, threads);
+
+    if (output.empty())
+    {
+        writeSweepTable(std::cout, results);
+        return 0;
+    }
+
+    std::ofstream out(output);
+    if (!out)
+    {
+        std::cerr << "Cannot open " << output << "\n";
+        return 1;
+    }
+    writeSweepTable(out, results);
+    return 0;
+}
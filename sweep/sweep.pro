@@ -0,0 +1,17 @@
+#-------------------------------------------------
+#
+# Parameter sweep: runs the cross product of profiles, methods, nx and nt
+# in parallel and writes one summary table.
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+CONFIG += console c++14 thread
+CONFIG -= app_bundle qt
+
+TARGET = TransportEquation1DSweep
+
+SOURCES += \
+        main.cpp
+
+include(../solver/solver.pri)
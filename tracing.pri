@@ -0,0 +1,3 @@
+# Scoped timers for the hot paths, exported as Chrome trace JSON. Off by
+# default; enable with qmake CONFIG+=tracing so that every project agrees.
+tracing: DEFINES += TRANSPORT_TRACING